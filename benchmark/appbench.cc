@@ -0,0 +1,292 @@
+#include "itensor/all.h"
+#include "bench.h"
+#include <thread>
+
+using namespace itensor;
+
+//
+// End-to-end benchmarks of the main algorithms:
+// DMRG for the Heisenberg chain and the 2D Hubbard model,
+// TEBD with gateTEvol, applyMPO with each method, AutoMPO
+// for a long-range Hamiltonian, METTS and concurrent
+// DMRG calculations on several threads.
+//
+// Each benchmark runs once with a fixed random seed and a
+// fixed sweep schedule, and records its wall time, the time
+// of each profiled phase, the peak memory of tensor storage
+// and checked results (energies, norms, bond dimensions).
+//
+// Calling this code as:
+// ./appbench [--filter=str] [--out=file] [--baseline=file]
+//            [--tolerance=0.1] [--checktol=1E-6] [--quick]
+// runs the benchmarks (see bench.h); the exit code is the
+// number of regressions against the baseline.
+//
+// The checked-in baseline, appbench_baseline.jsonl, is
+// compared with "make compare-app". Timings are specific to
+// the machine it was recorded on; update it with
+// "make baseline-app" after intentional changes.
+//
+
+MPO
+heisenbergMPO(SiteSet const& sites)
+    {
+    auto N = length(sites);
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    return toMPO(ampo);
+    }
+
+InitState
+neelState(SiteSet const& sites)
+    {
+    auto state = InitState(sites);
+    for(auto j : range1(length(sites))) state.set(j,j%2 == 1 ? "Up" : "Dn");
+    return state;
+    }
+
+//Collapse psi into a random product state in the Sz basis,
+//with probabilities given by psi, as in tutorial/finiteT
+void
+collapse(MPS& psi)
+    {
+    auto sites = siteInds(psi);
+    auto N = length(psi);
+    psi.position(1);
+    for(auto j : range1(N))
+        {
+        auto sj = sites(j);
+        auto PUp = ITensor(sj,prime(sj));
+        PUp.set(1,1,1.0);
+        auto prob_up = elt(dag(prime(psi(j),"Site"))*PUp*psi(j));
+        auto jstate = ITensor(sj);
+        jstate.set(Global::random() > prob_up ? 2 : 1,1.0);
+        if(j < N)
+            {
+            auto newA = psi(j+1)*(dag(jstate)*psi(j));
+            newA /= norm(newA);
+            psi.set(j+1,newA);
+            }
+        psi.set(j,jstate);
+        }
+    }
+
+int
+main(int argc, char* argv[])
+    {
+    auto opts = bench::Options(argc,argv);
+    auto R = bench::Runner(opts);
+    auto quick = opts.quick;
+
+    auto heis_psi = MPS{};
+    auto heis_H = MPO{};
+
+    R.run("dmrg/heisenberg",[&](bench::Result& r)
+        {
+        auto N = quick ? 20 : 100;
+        auto sites = SpinHalf(N);
+        auto H = heisenbergMPO(sites);
+        auto psi0 = randomMPS(neelState(sites));
+        auto sweeps = Sweeps(5);
+        sweeps.maxdim() = 10,20,100,100,200;
+        sweeps.cutoff() = 1E-10;
+        auto [energy,psi] = dmrg(H,psi0,sweeps,{"Silent=",true});
+        r.check("energy",energy);
+        r.add("max_bond_dim",maxLinkDim(psi));
+        heis_psi = psi;
+        heis_H = H;
+        });
+
+    //As dmrg/heisenberg, with the first three sweeps
+    //in single precision (see Sweeps::precision)
+    R.run("dmrg/heisenberg_precision32",[&](bench::Result& r)
+        {
+        auto N = quick ? 20 : 100;
+        auto sites = SpinHalf(N);
+        auto H = heisenbergMPO(sites);
+        auto psi0 = randomMPS(neelState(sites));
+        auto sweeps = Sweeps(5);
+        sweeps.maxdim() = 10,20,100,100,200;
+        sweeps.cutoff() = 1E-10;
+        sweeps.precision() = 32,32,32,64;
+        auto [energy,psi] = dmrg(H,psi0,sweeps,{"Silent=",true});
+        r.check("energy",energy);
+        r.add("max_bond_dim",maxLinkDim(psi));
+        });
+
+    R.run("dmrg/hubbard_2d",[&](bench::Result& r)
+        {
+        auto Nx = quick ? 3 : 6,
+             Ny = 2;
+        auto N = Nx*Ny;
+        auto sites = Electron(N);
+        auto t = 1.0,
+             U = 8.0;
+        auto ampo = AutoMPO(sites);
+        for(auto b : squareLattice(Nx,Ny,{"YPeriodic=",true}))
+            {
+            ampo += -t,"Cdagup",b.s1,"Cup",b.s2;
+            ampo += -t,"Cdagup",b.s2,"Cup",b.s1;
+            ampo += -t,"Cdagdn",b.s1,"Cdn",b.s2;
+            ampo += -t,"Cdagdn",b.s2,"Cdn",b.s1;
+            }
+        for(auto j : range1(N)) ampo += U,"Nupdn",j;
+        auto H = toMPO(ampo);
+        auto psi0 = MPS(neelState(sites));
+        auto sweeps = Sweeps(5);
+        sweeps.maxdim() = 10,20,100,200;
+        sweeps.noise() = 1E-7,1E-8,1E-10,0;
+        sweeps.cutoff() = 1E-8;
+        auto [energy,psi] = dmrg(H,psi0,sweeps,{"Silent=",true});
+        r.check("energy",energy);
+        r.add("max_bond_dim",maxLinkDim(psi));
+        });
+
+    R.run("tebd/heisenberg",[&](bench::Result& r)
+        {
+        auto N = quick ? 16 : 40;
+        auto sites = SpinHalf(N);
+        auto tstep = 0.05,
+             ttotal = quick ? 0.5 : 2.0;
+        auto gates = std::vector<BondGate>{};
+        for(auto b : range1(N-1))
+            {
+            auto hh = op(sites,"Sz",b)*op(sites,"Sz",b+1);
+            hh += 0.5*op(sites,"S+",b)*op(sites,"S-",b+1);
+            hh += 0.5*op(sites,"S-",b)*op(sites,"S+",b+1);
+            gates.push_back(BondGate(sites,b,b+1,BondGate::tReal,tstep/2.,hh));
+            }
+        for(auto b = N-1; b >= 1; --b)
+            {
+            gates.push_back(gates.at(b-1));
+            }
+        auto psi = MPS(neelState(sites));
+        gateTEvol(gates,ttotal,tstep,psi,{"Cutoff=",1E-9,"MaxDim=",200,"Verbose=",false,"ShowPercent=",false});
+        auto H = heisenbergMPO(sites);
+        r.check("energy",real(innerC(psi,H,psi)));
+        r.add("max_bond_dim",maxLinkDim(psi));
+        });
+
+    for(auto method : {"DensityMatrix","Fit"})
+        {
+        R.run(format("applyMPO/%s",method),[&](bench::Result& r)
+            {
+            if(!heis_psi) Error("applyMPO benchmarks require the dmrg/heisenberg benchmark");
+            auto Hpsi = applyMPO(heis_H,heis_psi,{"Method=",method,"Cutoff=",1E-10,"MaxDim=",200,"Nsweep=",2});
+            Hpsi.noPrime();
+            //Since heis_psi is close to the ground state, <psi|H|psi> = E
+            r.check("overlap",inner(heis_psi,Hpsi));
+            r.add("max_bond_dim",maxLinkDim(Hpsi));
+            });
+        }
+
+    R.run("autompo/long_range",[&](bench::Result& r)
+        {
+        auto N = quick ? 16 : 40;
+        auto sites = SpinHalf(N,{"ConserveQNs=",false});
+        auto ampo = AutoMPO(sites);
+        for(auto i : range1(N))
+        for(auto j : range1(i+1,N))
+            {
+            auto J = 1./((j-i)*(j-i));
+            ampo += 0.5*J,"S+",i,"S-",j;
+            ampo += 0.5*J,"S-",i,"S+",j;
+            ampo +=     J,"Sz",i,"Sz",j;
+            }
+        auto H = toMPO(ampo);
+        auto psi = MPS(neelState(sites));
+        r.check("neel_energy",inner(psi,H,psi));
+        r.check("max_bond_dim",maxLinkDim(H));
+        });
+
+    R.run("metts/heisenberg",[&](bench::Result& r)
+        {
+        auto N = quick ? 10 : 20;
+        auto beta = 2.,
+             tau = 0.1;
+        auto nwarm = 2,
+             nmetts = quick ? 3 : 10;
+        auto sites = SpinHalf(N,{"ConserveQNs=",false});
+        auto ampo = AutoMPO(sites);
+        for(auto j : range1(N-1))
+            {
+            ampo += 0.5,"S+",j,"S-",j+1;
+            ampo += 0.5,"S-",j,"S+",j+1;
+            ampo +=     "Sz",j,"Sz",j+1;
+            }
+        auto H = toMPO(ampo);
+        auto expH = toExpH(ampo,tau);
+        auto args = Args("MaxDim=",200,"Cutoff=",1E-10,"Method=","DensityMatrix");
+        auto psi = MPS(neelState(sites));
+        auto nt = int(beta/2./tau+1E-9);
+        auto en_stat = Stats{};
+        for(auto step : range1(nwarm+nmetts))
+            {
+            for(auto tt : range1(nt))
+                {
+                (void)tt;
+                psi = applyMPO(expH,psi,args);
+                psi.noPrime();
+                psi.ref(1) /= norm(psi(1));
+                }
+            if(step > nwarm) en_stat.putin(inner(psi,H,psi));
+            collapse(psi);
+            }
+        r.check("energy",en_stat.avg());
+        });
+
+    //Independent DMRG calculations on several threads,
+    //starting from the same MPO and MPS; "speedup" is the
+    //throughput relative to running them one at a time.
+    //Measured outside R.run, with memory tracking and
+    //profiling off: both take a global lock for every
+    //allocation or region and would serialize the threads.
+    //The speedup can only approach nthread on a machine
+    //with at least nthread cores ("hardware_threads").
+    if(R.selected("dmrg/concurrent"))
+        {
+        auto r = bench::Result{};
+        r.name = "dmrg/concurrent";
+        seedRNG(1);
+        auto N = quick ? 10 : 30;
+        auto nthread = 4;
+        auto sites = SpinHalf(N);
+        auto H = heisenbergMPO(sites);
+        auto psi0 = randomMPS(neelState(sites));
+        auto sweeps = Sweeps(5);
+        sweeps.maxdim() = 10,20,50;
+        sweeps.cutoff() = 1E-10;
+        auto run = [&] { return std::get<0>(dmrg(H,psi0,sweeps,{"Silent=",true})); };
+
+        auto serial = cpu_time();
+        auto E0 = run();
+        auto serial_time = serial.sincemark().wall;
+
+        auto energies = std::vector<Real>(nthread);
+        auto concurrent = cpu_time();
+        auto threads = std::vector<std::thread>{};
+        for(auto t : range(nthread))
+            {
+            threads.emplace_back([&,t] { energies[t] = run(); });
+            }
+        for(auto& th : threads) th.join();
+        auto concurrent_time = concurrent.sincemark().wall;
+
+        auto spread = 0.;
+        for(auto E : energies) spread = std::max(spread,std::fabs(E-E0));
+        r.time = concurrent_time;
+        r.check("energy",E0);
+        r.add("energy_spread",spread);
+        r.add("nthread",nthread);
+        r.add("hardware_threads",hardwareThreads());
+        r.add("speedup",nthread*serial_time/concurrent_time);
+        R.record(std::move(r));
+        }
+
+    return R.finish();
+    }
@@ -0,0 +1,322 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_BENCH_H
+#define __ITENSOR_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "itensor/util/print.h"
+#include "itensor/util/iterate.h"
+#include "itensor/util/perfcounters.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/memory_usage.h"
+#include "itensor/global.h"
+
+//
+// Minimal benchmark harness shared by the programs in
+// this directory.
+//
+// Results are written as JSON Lines, one object per
+// benchmark, and can be compared against a baseline file
+// written by an earlier run. A benchmark is flagged as a
+// regression if its time is slower than the baseline by
+// more than the tolerance (relative, e.g. 0.1 = 10%), or
+// if one of its checked results (e.g. a final energy) 
+// differs from the baseline by more than the check
+// tolerance.
+//
+// Common command line options:
+//   --filter=str     run only benchmarks whose name contains str
+//   --out=file       write results to file (default: none)
+//   --baseline=file  compare against results in file
+//   --tolerance=x    relative slowdown flagged as regression
+//   --checktol=x     allowed difference of checked results
+//                    (relative to max(1,|baseline|), default 1E-6)
+//   --quick          fewer repetitions or smaller systems,
+//                    for smoke tests
+//
+
+namespace itensor {
+namespace bench {
+
+struct Options
+    {
+    std::string filter;
+    std::string out;
+    std::string baseline;
+    double tolerance = 0.1;
+    double checktol = 1E-6;
+    bool quick = false;
+    std::map<std::string,std::string> extra;
+
+    Options(int argc, char* argv[])
+        {
+        for(auto n : range1(argc-1))
+            {
+            auto a = std::string(argv[n]);
+            auto eq = a.find('=');
+            auto key = a.substr(0,eq);
+            auto val = (eq == std::string::npos) ? std::string() : a.substr(eq+1);
+            if(key == "--filter") filter = val;
+            else if(key == "--out") out = val;
+            else if(key == "--baseline") baseline = val;
+            else if(key == "--tolerance") tolerance = std::atof(val.c_str());
+            else if(key == "--checktol") checktol = std::atof(val.c_str());
+            else if(key == "--quick") quick = true;
+            else if(key.substr(0,2) == "--") extra[key.substr(2)] = val;
+            else
+                {
+                printfln("Unrecognized argument \"%s\"",a);
+                std::exit(1);
+                }
+            }
+        }
+
+    bool
+    selected(std::string const& name) const
+        {
+        return filter.empty() || name.find(filter) != std::string::npos;
+        }
+    };
+
+//One result; "time" and the checked values are compared
+//against the baseline, other values are informational
+struct Result
+    {
+    std::string name;
+    double time = 0;
+    std::vector<std::pair<std::string,double>> values;
+    std::vector<std::pair<std::string,std::string>> labels;
+
+    Result&
+    add(std::string key, double val) { values.emplace_back(std::move(key),val); return *this; }
+
+    //Checked values are stored with the prefix "check_"
+    Result&
+    check(std::string key, double val) { return add("check_"+key,val); }
+
+    Result&
+    label(std::string key, std::string val) { labels.emplace_back(std::move(key),std::move(val)); return *this; }
+    };
+
+std::string inline
+toJSON(Result const& r)
+    {
+    auto s = format("{\"name\":\"%s\",\"time\":%.9g",r.name,r.time);
+    for(auto& [k,v] : r.values) s += format(",\"%s\":%.9g",k,v);
+    for(auto& [k,v] : r.labels) s += format(",\"%s\":\"%s\"",k,v);
+    return s + "}";
+    }
+
+using Baseline = std::map<std::string,std::map<std::string,double>>;
+
+//Read the numeric fields of each line of a results
+//file written by Runner::finish, by benchmark name
+Baseline inline
+readBaseline(std::string const& fname)
+    {
+    auto res = Baseline{};
+    auto f = std::ifstream(fname);
+    if(!f.is_open())
+        {
+        printfln("No baseline file \"%s\": record one by running with --out=%s",fname,fname);
+        printfln("(\"make baseline\" or \"make baseline-app\" in the benchmark directory)");
+        std::exit(1);
+        }
+    for(std::string l; std::getline(f,l);)
+        {
+        //Lines have the form {"key":value,"key":"string",...}
+        //with no nested objects or escaped quotes
+        auto name = std::string();
+        auto vals = std::map<std::string,double>{};
+        auto p = l.find('"');
+        while(p != std::string::npos)
+            {
+            auto ke = l.find('"',p+1);
+            auto key = l.substr(p+1,ke-p-1);
+            auto vb = ke+2;
+            auto ve = vb;
+            if(l[vb] == '"')
+                {
+                ve = l.find('"',vb+1)+1;
+                if(key == "name") name = l.substr(vb+1,ve-vb-2);
+                }
+            else
+                {
+                ve = l.find_first_of(",}",vb);
+                vals[key] = std::atof(l.substr(vb,ve-vb).c_str());
+                }
+            p = l.find('"',ve);
+            }
+        if(!name.empty()) res[name] = vals;
+        }
+    return res;
+    }
+
+class Runner
+    {
+    Options opts_;
+    std::vector<Result> results_;
+    public:
+
+    explicit
+    Runner(Options opts) : opts_(std::move(opts)) { }
+
+    Options const&
+    options() const { return opts_; }
+
+    bool
+    selected(std::string const& name) const { return opts_.selected(name); }
+
+    //Time f repeatedly (after one warm-up call) and record
+    //the minimum time per call; flops, if given, is the
+    //operation count of a single call, otherwise it is
+    //taken from the performance counters during warm-up
+    void
+    time(std::string const& name,
+         std::function<void()> f,
+         double flops = 0)
+        {
+        if(!selected(name)) return;
+        using clock = std::chrono::steady_clock;
+        auto min_reps = opts_.quick ? 2 : 5;
+        auto min_total = opts_.quick ? 0.02 : 0.3;
+        resetPerfCounters();
+        setPerfCounting(true);
+        f();
+        setPerfCounting(false);
+        if(flops == 0) flops = perfCounters().flops();
+        auto times = std::vector<double>{};
+        auto total = 0.;
+        while(int(times.size()) < min_reps || (total < min_total && times.size() < 10000))
+            {
+            auto start = clock::now();
+            f();
+            times.push_back(std::chrono::duration<double>(clock::now()-start).count());
+            total += times.back();
+            }
+        std::sort(times.begin(),times.end());
+        auto r = Result{};
+        r.name = name;
+        r.time = times.front();
+        r.add("median",times[times.size()/2]);
+        r.add("reps",times.size());
+        if(flops > 0) r.add("gflops",1E-9*flops/r.time);
+        printfln("%-44s %12.6f s  (median %.6f, reps %d)%s",name,r.time,times[times.size()/2],times.size(),
+                 flops > 0 ? format(", %.2f GFlop/s",1E-9*flops/r.time) : std::string());
+        results_.push_back(std::move(r));
+        }
+
+    //Run f once as an end-to-end benchmark (with the random
+    //number generator seeded), recording its wall time, the
+    //peak memory of tensor storage and the time spent in
+    //each profiled region taking over 1% of the total (as
+    //"phase_<region>"); f can add checked values to r
+    void
+    run(std::string const& name,
+        std::function<void(Result& r)> f)
+        {
+        if(!selected(name)) return;
+        auto r = Result{};
+        r.name = name;
+        seedRNG(1);
+        setMemoryTracking(true);
+        resetMemoryPeaks();
+        clearProfile();
+        setProfiling(true);
+        f(r);
+        auto S = profileSummary();
+        setProfiling(false);
+        setMemoryTracking(false);
+        r.time = S.wall;
+        r.add("mem_peak_mb",1E-6*memoryUsage().peak);
+        for(auto& e : S.entries)
+            {
+            if(e.time > 0.01*S.wall) r.add("phase_"+e.name,e.time);
+            }
+        record(std::move(r));
+        }
+
+    //Record a result measured by the caller
+    void
+    record(Result r)
+        {
+        printfln("%-44s %12.6f s",r.name,r.time);
+        for(auto& [k,v] : r.values) printfln("    %-40s %.10g",k,v);
+        results_.push_back(std::move(r));
+        }
+
+    std::vector<Result> const&
+    results() const { return results_; }
+
+    //Write results and compare against the baseline (if
+    //requested); returns the number of regressions, to be
+    //used as the exit code of the program
+    int
+    finish() const
+        {
+        if(!opts_.out.empty())
+            {
+            auto f = std::ofstream(opts_.out);
+            for(auto& r : results_) f << toJSON(r) << "\n";
+            printfln("\nWrote %d results to \"%s\"",results_.size(),opts_.out);
+            }
+        if(opts_.baseline.empty()) return 0;
+
+        auto base = readBaseline(opts_.baseline);
+        printfln("\nComparison with baseline \"%s\" (tolerance %.0f%%):",opts_.baseline,100*opts_.tolerance);
+        auto nregress = 0;
+        for(auto& r : results_)
+            {
+            auto it = base.find(r.name);
+            if(it == base.end() || it->second["time"] <= 0)
+                {
+                printfln("  %-44s      (not in baseline)",r.name);
+                continue;
+                }
+            auto& b = it->second;
+            auto ratio = r.time/b["time"];
+            auto flag = std::string();
+            if(ratio > 1+opts_.tolerance) { flag = "  REGRESSION"; ++nregress; }
+            else if(ratio < 1-opts_.tolerance) flag = "  improved";
+            printfln("  %-44s %8.3fx%s",r.name,ratio,flag);
+            for(auto& [k,v] : r.values)
+                {
+                if(k.substr(0,6) != "check_" || !b.count(k)) continue;
+                auto diff = std::fabs(v-b[k]);
+                if(diff > opts_.checktol*std::max(1.,std::fabs(b[k])))
+                    {
+                    printfln("    %s = %.12g differs from baseline %.12g  REGRESSION",k.substr(6),v,b[k]);
+                    ++nregress;
+                    }
+                }
+            }
+        printfln("%d regression(s)",nregress);
+        return nregress;
+        }
+    };
+
+} //namespace bench
+} //namespace itensor
+
+#endif
@@ -0,0 +1,272 @@
+#include "itensor/all.h"
+#include "bench.h"
+
+using namespace itensor;
+
+//
+// Microbenchmarks of the core tensor kernels:
+// matrix multiplication (real and complex), permutation,
+// element-wise transformation, randomization, dense and block-sparse
+// contraction, svd, diagHermitian and combiners.
+//
+// Block-sparse (QDense) shapes are taken from the tensors
+// of a ground state MPS of the Heisenberg chain computed
+// with DMRG, at the center bond.
+//
+// Calling this code as:
+// ./microbench [--m=100] [--filter=str] [--out=file]
+//              [--baseline=file] [--tolerance=0.1] [--quick]
+// runs all benchmarks with bond dimension m (default 100),
+// prints the time per call and writes the results to
+// "file" (see bench.h).
+//
+// To update the stored baseline: make baseline
+// To compare against it: make compare
+//
+
+int
+main(int argc, char* argv[])
+    {
+    auto opts = bench::Options(argc,argv);
+    auto R = bench::Runner(opts);
+    auto quick = opts.quick;
+    long m = opts.extra.count("m") ? std::atol(opts.extra.at("m").c_str()) : (quick ? 20 : 100);
+
+    seedRNG(1);
+
+    //
+    // Matrix multiplication
+    //
+    auto Ns = quick ? std::vector<long>{64,128} : std::vector<long>{64,256,1024};
+    for(auto N : Ns)
+        {
+        auto A = randomMat(N,N),
+             B = randomMat(N,N),
+             C = Matrix(N,N);
+        R.time(format("gemm/real/N=%d",N),[&] { mult(A,B,C); },2.*N*N*N);
+        R.time(format("gemm/real_precision32/N=%d",N),[&]
+            {
+            SET_SCOPED(gemmSinglePrecision()) = true;
+            mult(A,B,C);
+            },2.*N*N*N);
+
+        auto cA = CMatrix(N,N),
+             cB = CMatrix(N,N),
+             cC = CMatrix(N,N);
+        for(auto& el : cA) el = Cplx(Global::random(),Global::random());
+        for(auto& el : cB) el = Cplx(Global::random(),Global::random());
+        R.time(format("gemm/cplx/N=%d",N),[&] { mult(cA,cB,cC); },8.*N*N*N);
+        }
+
+    //
+    // Dense tensors with MPS-like shapes
+    //
+    auto s1 = Index(2,"Site,n=1"),
+         s2 = Index(2,"Site,n=2"),
+         l = Index(m,"Link,l=1"),
+         r = Index(m,"Link,l=2"),
+         w1 = Index(5,"Link,MPO,1"),
+         w2 = Index(5,"Link,MPO,2");
+
+    auto phi = randomITensor(l,s1,s2,r);
+    R.time(format("permute/dense/m=%d",m),[&] { auto P = permute(phi,r,s2,s1,l); });
+    R.time(format("transform/dense/m=%d",m),[&] { phi.apply([](Real x) { return 0.5*x; }); });
+    R.time(format("scale/dense/m=%d",m),[&] { phi *= 1.0001; });
+
+    auto L = randomITensor(l,w1,prime(l));
+    auto W = randomITensor(w1,s1,prime(s1),w2);
+    auto A = randomITensor(l,s1,r);
+    R.time(format("contract/dense/env_update/m=%d",m),[&]
+        {
+        auto nL = L*A;
+        nL *= W;
+        nL *= dag(prime(A));
+        });
+    auto Ad = dag(prime(A));
+    auto nL = ITensor{};
+    auto scratch = NetworkScratch{};
+    R.time(format("contract/dense/env_update_network/m=%d",m),[&]
+        {
+        contractNetwork({&L,&A,&W,&Ad},nL,scratch);
+        });
+    auto Lp = randomITensor(l,w1,prime(l));
+    auto W2 = randomITensor(w2,s2,prime(s2),prime(w2,2));
+    auto Rpp = randomITensor(r,prime(w2,2),prime(r));
+    R.time(format("contract/dense/two_site_product/m=%d",m),[&]
+        {
+        auto Hphi = Lp*phi;
+        Hphi *= W;
+        Hphi *= W2;
+        Hphi *= Rpp;
+        });
+    auto work = std::array<ITensor,4>{};
+    R.time(format("contract/dense/two_site_product_into/m=%d",m),[&]
+        {
+        contractInto(Lp,phi,work[0]);
+        contractInto(work[0],W,work[1]);
+        contractInto(work[1],W2,work[2]);
+        contractInto(work[2],Rpp,work[3]);
+        });
+
+    auto phi2 = randomITensor(r,s2,s1,l);
+    R.time(format("dot/dense/contract/m=%d",m),[&] { auto z = eltC(dag(phi)*phi2); (void)z; },2.*dim(inds(phi)));
+    R.time(format("dot/dense/dotC/m=%d",m),[&] { auto z = dotC(phi,phi2); (void)z; },2.*dim(inds(phi)));
+
+    R.time(format("svd/dense/two_site/m=%d",m),[&]
+        {
+        auto [U,S,V] = svd(phi,{l,s1},{"MaxDim=",m,"Cutoff=",0.});
+        });
+
+    auto rho = randomITensor(l,s1,prime(l),prime(s1));
+    rho += swapPrime(rho,0,1);
+    R.time(format("diagHermitian/dense/m=%d",m),[&]
+        {
+        auto [U,D] = diagHermitian(rho,{"MaxDim=",2*m,"Cutoff=",0.});
+        });
+
+    for(auto nthread : {1,4})
+        {
+        R.time(format("randomize/dense/m=%d/nthread=%d",m,nthread),[&]
+            {
+            phi.randomize({"NThread=",nthread});
+            });
+        }
+
+    auto [C,ci] = combiner(l,s1);
+    R.time(format("combiner/dense/m=%d",m),[&] { auto cphi = phi*C; });
+
+    //
+    // Args: the pattern of a dmrg bond step, which copies
+    // the Args, adds a few values and looks up options
+    // (some not defined, falling back to defaults)
+    //
+    auto args = Args("Cutoff",1E-10,"MaxDim",m,"MinDim",1,"Noise",0.,"MaxIter",2,
+                     "Sweep",1,"NSweep",5,"Quiet",true,"DebugLevel",-1,"DoNormalize",true);
+    auto sink = 0.;
+    R.time("args/bond_step_x100",[&]
+        {
+        for(auto b : range(100))
+            {
+            auto a = args;
+            a.add("AtBond",b);
+            a.add("HalfSweep",1);
+            a.add("Energy",-1.);
+            a.add("Truncerr",0.);
+            sink += a.getReal("Cutoff",0.) + a.getInt("MaxDim",0) + a.getInt("MinDim",1)
+                  + a.getSizeT("MaxIter",2) + a.getReal("ErrGoal",1E-14) + a.getInt("DebugLevel",-1)
+                  + a.getBool("Quiet",false) + a.getBool("UseSVD",false) + a.getReal("Noise",0.)
+                  + a.getString("LeftTags","Link").size();
+            }
+        });
+    //Same, with names interned once as in the library algorithms
+    auto AtBond = ArgName("AtBond"), HalfSweep = ArgName("HalfSweep"), Energy = ArgName("Energy"),
+         Truncerr = ArgName("Truncerr"), Cutoff = ArgName("Cutoff"), MaxDim = ArgName("MaxDim"),
+         MinDim = ArgName("MinDim"), MaxIter = ArgName("MaxIter"), ErrGoal = ArgName("ErrGoal"),
+         DebugLevel = ArgName("DebugLevel"), Quiet = ArgName("Quiet"), UseSVD = ArgName("UseSVD"),
+         Noise = ArgName("Noise"), LeftTags = ArgName("LeftTags");
+    R.time("args/bond_step_interned_x100",[&]
+        {
+        for(auto b : range(100))
+            {
+            auto a = args;
+            a.add(AtBond,b);
+            a.add(HalfSweep,1);
+            a.add(Energy,-1.);
+            a.add(Truncerr,0.);
+            sink += a.getReal(Cutoff,0.) + a.getInt(MaxDim,0) + a.getInt(MinDim,1)
+                  + a.getSizeT(MaxIter,2) + a.getReal(ErrGoal,1E-14) + a.getInt(DebugLevel,-1)
+                  + a.getBool(Quiet,false) + a.getBool(UseSVD,false) + a.getReal(Noise,0.)
+                  + a.getString(LeftTags,"Link").size();
+            }
+        });
+    if(sink < 0.) println("(args sink)");
+
+    //
+    // Block-sparse tensors from a DMRG ground state
+    //
+    auto N = quick ? 10 : 20;
+    auto sites = SpinHalf(N);
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    auto H = toMPO(ampo);
+    auto state = InitState(sites);
+    for(auto i : range1(N)) state.set(i,i%2 == 1 ? "Up" : "Dn");
+    auto psi = randomMPS(state);
+    auto sweeps = Sweeps(quick ? 2 : 5);
+    sweeps.maxdim() = 10,20,m;
+    sweeps.cutoff() = 1E-12;
+    dmrg(psi,H,sweeps,{"Silent",true});
+
+    auto b = N/2;
+    auto PH = LocalMPO(H);
+    psi.position(b);
+    PH.position(b,psi);
+    auto qphi = psi(b)*psi(b+1);
+    auto qm = dim(linkIndex(psi,b));
+    printfln("QN tensors at center bond of a DMRG ground state, bond dimension %d",qm);
+
+    R.time(format("contract/qdense/two_site_product/m=%d",m),[&]
+        {
+        auto Hphi = ITensor{};
+        PH.product(qphi,Hphi);
+        });
+    //Sum of four MPOs, as when H is split to keep
+    //the MPO bond dimension small
+    auto Hset = std::vector<MPO>(4,H);
+    for(auto nthread : {1,4})
+        {
+        auto PHset = LocalMPOSet(Hset,{"NThread=",nthread});
+        PHset.position(b,psi);
+        auto Hphi = ITensor{};
+        R.time(format("localmposet/qdense/product/m=%d/nthread=%d",m,nthread),[&]
+            {
+            PHset.product(qphi,Hphi);
+            });
+        }
+    auto qphi2 = permute(randomITensor(div(qphi),inds(qphi)),inds(qphi)(4),inds(qphi)(3),inds(qphi)(2),inds(qphi)(1));
+    R.time(format("dot/qdense/contract/m=%d",m),[&] { auto z = eltC(dag(qphi)*qphi2); (void)z; });
+    R.time(format("dot/qdense/dotC/m=%d",m),[&] { auto z = dotC(qphi,qphi2); (void)z; });
+    R.time(format("contract/qdense/env_update/m=%d",m),[&]
+        {
+        auto nL = PH.L()*psi(b);
+        nL *= H(b);
+        nL *= dag(prime(psi(b)));
+        });
+    auto qAd = dag(prime(psi(b)));
+    auto qnL = ITensor{};
+    R.time(format("contract/qdense/env_update_network/m=%d",m),[&]
+        {
+        contractNetwork({&PH.L(),&psi(b),&H(b),&qAd},qnL,scratch);
+        });
+    R.time(format("mps/qdense/correlationMatrix/m=%d",m),[&]
+        {
+        auto C = correlationMatrix(sites,psi,"S+","S-",{"NThread=",1});
+        });
+    R.time(format("mps/qdense/sample/m=%d/nsample=1000",m),[&]
+        {
+        auto S = sample(psi,1000,{"NThread=",1});
+        });
+    auto qlink = findIndex(qphi,format("Link,l=%d",b-1));
+    R.time(format("permute/qdense/m=%d",m),[&]
+        {
+        auto P = permute(qphi,findIndex(qphi,format("Link,l=%d",b+1)),sites(b+1),sites(b),qlink);
+        });
+    R.time(format("svd/qdense/two_site/m=%d",m),[&]
+        {
+        auto [U,S,V] = svd(qphi,{qlink,sites(b)},{"MaxDim=",qm,"Cutoff=",0.});
+        });
+    auto qrho = qphi*dag(prime(qphi,qlink,sites(b)));
+    R.time(format("diagHermitian/qdense/m=%d",m),[&]
+        {
+        auto [U,D] = diagHermitian(qrho,{"MaxDim=",2*qm,"Cutoff=",0.});
+        });
+    auto [qC,qci] = combiner(qlink,sites(b));
+    R.time(format("combiner/qdense/m=%d",m),[&] { auto cphi = qphi*qC; });
+
+    return R.finish();
+    }
@@ -35,7 +35,9 @@
 #include "itensor/util/stats.h"
 
 #include "itensor/mps/dmrg.h"
+#include "itensor/mps/idmrg.h"
 #include "itensor/mps/tevol.h"
+#include "itensor/mps/metts.h"
 #include "itensor/mps/autompo.h"
 
 #include "itensor/mps/lattice/square.h"
@@ -0,0 +1,271 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstdint>
+#include "itensor/contractnetwork.h"
+
+namespace itensor {
+
+using std::vector;
+using std::pair;
+using ContractOrder = vector<pair<int,int>>;
+
+namespace detail {
+
+//
+// The indices of a tensor are stored as a bit set,
+// bit l standing for the l'th distinct index of the
+// network. The product of two tensors has the indices
+// of one or the other but not both (exclusive or).
+//
+using Labels = uint64_t;
+
+struct NetworkNode
+    {
+    int id = 0;
+    Labels labels = 0;
+    };
+
+struct Network
+    {
+    vector<NetworkNode> nodes;
+    vector<Real> dims;
+    bool valid = true;
+
+    //valid is false if there are more than 64 distinct
+    //indices or an index is in more than two tensors
+    Network(vector<IndexSet> const& inds)
+        {
+        auto uniq = vector<Index const*>{};
+        auto count = vector<int>{};
+        nodes.resize(inds.size());
+        for(auto j : range(inds.size()))
+            {
+            nodes[j].id = j;
+            for(auto& i : inds[j])
+                {
+                size_t l = 0;
+                while(l < uniq.size() && *uniq[l] != i) ++l;
+                if(l == uniq.size())
+                    {
+                    if(l == 64) { valid = false; return; }
+                    uniq.push_back(&i);
+                    dims.push_back(dim(i));
+                    count.push_back(0);
+                    }
+                if(++count[l] > 2) valid = false;
+                nodes[j].labels |= Labels(1) << l;
+                }
+            }
+        }
+
+    Real
+    cost(Labels a, Labels b) const
+        {
+        Real c = 1.;
+        auto u = a | b;
+        for(size_t l = 0; u != 0; ++l, u >>= 1)
+            {
+            if(u & 1) c *= dims[l];
+            }
+        return c;
+        }
+    };
+
+//Contract nodes a and b (a < b) of N into a
+//new node with number id, placed at position a
+void
+contractNodes(vector<NetworkNode> & N,
+              size_t a,
+              size_t b,
+              int id)
+    {
+    N[a].id = id;
+    N[a].labels ^= N[b].labels;
+    N.erase(N.begin()+b);
+    }
+
+ContractOrder
+leftToRight(int n)
+    {
+    auto order = ContractOrder{};
+    for(int s = 0; s+1 < n; ++s)
+        {
+        order.emplace_back(s == 0 ? 0 : n+s-1,s+1);
+        }
+    return order;
+    }
+
+Real
+orderCost(Network N,
+          ContractOrder const& order)
+    {
+    auto& nodes = N.nodes;
+    auto n = int(nodes.size());
+    Real cost = 0.;
+    for(auto s : range(order.size()))
+        {
+        size_t a = nodes.size(),
+               b = nodes.size();
+        for(auto k : range(nodes.size()))
+            {
+            if(nodes[k].id == order[s].first) a = k;
+            if(nodes[k].id == order[s].second) b = k;
+            }
+        if(a == nodes.size() || b == nodes.size() || a == b) Error("Invalid contraction order");
+        cost += N.cost(nodes[a].labels,nodes[b].labels);
+        if(a > b) std::swap(a,b);
+        contractNodes(nodes,a,b,n+int(s));
+        }
+    return cost;
+    }
+
+struct OrderSearch
+    {
+    Network const& net;
+    int next_id = 0;
+    Real best = 0.;
+    ContractOrder best_order;
+    ContractOrder order;
+
+    OrderSearch(Network const& net_) : net(net_) { }
+
+    void
+    search(vector<NetworkNode> const& N, Real cost)
+        {
+        if(N.size() == 1)
+            {
+            //Equal costs keep the order found first
+            if(cost < best*(1.-1E-12))
+                {
+                best = cost;
+                best_order = order;
+                }
+            return;
+            }
+        for(size_t a = 0; a < N.size(); ++a)
+        for(size_t b = a+1; b < N.size(); ++b)
+            {
+            auto c = cost+net.cost(N[a].labels,N[b].labels);
+            if(c >= best) continue;
+            auto M = N;
+            auto id = next_id+int(order.size());
+            order.emplace_back(N[a].id,N[b].id);
+            contractNodes(M,a,b,id);
+            search(M,c);
+            order.pop_back();
+            }
+        }
+    };
+
+} //namespace detail
+
+Real
+contractionCost(vector<IndexSet> const& inds,
+                ContractOrder const& order)
+    {
+    auto N = detail::Network(inds);
+    if(!N.valid) Error("contractionCost: more than 64 indices or an index in more than two tensors");
+    return detail::orderCost(N,order);
+    }
+
+ContractOrder
+contractionOrder(vector<IndexSet> const& inds)
+    {
+    auto n = int(inds.size());
+    auto order = detail::leftToRight(n);
+    if(n <= 2) return order;
+
+    //The product of ITensors contracts every index the two
+    //share, so an index in three or more tensors makes the
+    //result depend on the order
+    auto net = detail::Network(inds);
+    if(!net.valid) return order;
+
+    auto N = net.nodes;
+    if(n <= 6)
+        {
+        auto S = detail::OrderSearch(net);
+        S.next_id = n;
+        S.best = detail::orderCost(net,order);
+        S.best_order = order;
+        S.search(N,0.);
+        return S.best_order;
+        }
+
+    //Greedy: contract the cheapest pair at each step,
+    //preferring pairs further left
+    order.clear();
+    while(N.size() > 1)
+        {
+        size_t ba = 0,
+               bb = 1;
+        auto best = net.cost(N[0].labels,N[1].labels);
+        for(size_t a = 0; a < N.size(); ++a)
+        for(size_t b = a+1; b < N.size(); ++b)
+            {
+            auto c = net.cost(N[a].labels,N[b].labels);
+            if(c < best)
+                {
+                best = c;
+                ba = a;
+                bb = b;
+                }
+            }
+        order.emplace_back(N[ba].id,N[bb].id);
+        detail::contractNodes(N,ba,bb,n+int(order.size())-1);
+        }
+    return order;
+    }
+
+void
+contractNetwork(vector<ITensor const*> const& T,
+                ITensor & res,
+                NetworkScratch & scratch)
+    {
+    auto F = vector<ITensor const*>{};
+    F.reserve(T.size());
+    for(auto* t : T) if(t && *t) F.push_back(t);
+    if(F.empty()) Error("No ITensors to contract in contractNetwork");
+    if(F.size() == 1)
+        {
+        if(F[0] != &res) res = *F[0];
+        return;
+        }
+
+    auto n = int(F.size());
+    auto inds = vector<IndexSet>(n);
+    for(auto j : range(n)) inds[j] = F[j]->inds();
+    auto order = contractionOrder(inds);
+
+    //Make room for all intermediates first, since
+    //growing scratch moves its ITensors
+    auto nstep = int(order.size());
+    if(nstep > 1) scratch[nstep-2];
+    auto tensor = [&](int id) -> ITensor const&
+        {
+        if(id < n) return *F[id];
+        return scratch[id-n];
+        };
+    for(auto s : range(nstep))
+        {
+        auto& A = tensor(order[s].first);
+        auto& B = tensor(order[s].second);
+        if(s+1 == nstep) contractInto(A,B,res);
+        else             contractInto(A,B,scratch[s]);
+        }
+    }
+
+} //namespace itensor
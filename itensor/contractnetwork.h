@@ -0,0 +1,99 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_CONTRACTNETWORK_H
+#define __ITENSOR_CONTRACTNETWORK_H
+
+#include <utility>
+#include <vector>
+#include "itensor/itensor.h"
+
+//
+// Contraction of a small network of ITensors,
+// such as the update of an MPS environment
+// E*A*W*dag(prime(A)), in the cheapest pairwise order
+//
+
+namespace itensor {
+
+//
+// Work space holding the intermediate products of
+// contractNetwork. Intermediates are written into
+// the same entries on every call, so their storage
+// is reused when the indices repeat.
+//
+class NetworkScratch
+    {
+    std::vector<ITensor> work_;
+    public:
+
+    NetworkScratch() { }
+
+    ITensor&
+    operator[](size_t n)
+        {
+        if(n >= work_.size()) work_.resize(n+1);
+        return work_[n];
+        }
+
+    size_t
+    size() const { return work_.size(); }
+
+    void
+    clear() { work_.clear(); }
+    };
+
+//
+// Pairwise contraction order for tensors with the
+// given indices. Tensors are numbered 0,1,...,n-1 in
+// the order given and the product of step s is
+// numbered n+s; each step is the pair of numbers of
+// the tensors it contracts.
+//
+// The cost of a step is the product of the dimensions
+// of all indices of the two tensors. Up to 6 tensors
+// all orders are tried, for more a greedy order is
+// used. Among orders of equal cost the left-to-right
+// order is preferred. If an index appears in more than
+// two tensors the result depends on the order, so the
+// left-to-right order is returned.
+//
+std::vector<std::pair<int,int>>
+contractionOrder(std::vector<IndexSet> const& inds);
+
+//Total cost of contracting tensors with the given
+//indices in the given order (see contractionOrder)
+Real
+contractionCost(std::vector<IndexSet> const& inds,
+                std::vector<std::pair<int,int>> const& order);
+
+//
+// Set res to the product of the ITensors pointed to
+// by T, contracted in the order chosen by
+// contractionOrder. Intermediate products are kept in
+// scratch and the last product is written into res
+// (see contractInto), so repeated calls with the same
+// index structure do not allocate.
+// Null pointers and default constructed ITensors
+// are skipped. res may be one of the factors.
+//
+void
+contractNetwork(std::vector<ITensor const*> const& T,
+                ITensor & res,
+                NetworkScratch & scratch);
+
+} //namespace itensor
+
+#endif
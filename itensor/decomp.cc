@@ -20,6 +20,8 @@
 #include "itensor/tensor/algs.h"
 #include "itensor/decomp.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/memory_usage.h"
 #include "itensor/itdata/qutil.h"
 
 namespace itensor {
@@ -122,42 +124,53 @@ svd(ITensor const& AA,
     ITensor & V,
     Args args)
     {
-    if( args.defined("Minm") )
+    static const auto Minm = ArgName("Minm");
+    static const auto MinDim = ArgName("MinDim");
+    static const auto Maxm = ArgName("Maxm");
+    static const auto MaxDim = ArgName("MaxDim");
+    static const auto UseOrigM = ArgName("UseOrigM");
+    static const auto UseOrigDim = ArgName("UseOrigDim");
+    static const auto Noise = ArgName("Noise");
+    static const auto Cutoff = ArgName("Cutoff");
+
+    PROFILE_REGION("svd");
+    auto mem_scope = MemoryScope("svd");
+    if( args.defined(Minm) )
       {
-      if( args.defined("MinDim") )
+      if( args.defined(MinDim) )
         {
         Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
+        args.add(MinDim,args.getInt(Minm));
         }
       }
 
-    if( args.defined("Maxm") )
+    if( args.defined(Maxm) )
       {
-      if( args.defined("MaxDim") )
+      if( args.defined(MaxDim) )
         {
         Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
+        args.add(MaxDim,args.getInt(Maxm));
         }
       }
 
-    if( args.defined("UseOrigM") )
+    if( args.defined(UseOrigM) )
       {
-      if( args.defined("UseOrigDim") )
+      if( args.defined(UseOrigDim) )
         {
         Global::warnDeprecated("Args UseOrigM and UseOrigDim are both defined. UseOrigM is deprecated in favor of UseOrigDim, UseOrigDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg UseOrigM is deprecated in favor of UseOrigDim.");
-        args.add("UseOrigDim",args.getBool("UseOrigM"));
+        args.add(UseOrigDim,args.getBool(UseOrigM));
         }
       }
 
@@ -166,8 +179,8 @@ svd(ITensor const& AA,
         Error("U and V default-initialized in svd, must indicate at least one index on U or V");
 #endif
 
-    auto noise = args.getReal("Noise",0);
-    auto useOrigDim = args.getBool("UseOrigDim",false);
+    auto noise = args.getReal(Noise,0);
+    auto useOrigDim = args.getBool(UseOrigDim,false);
 
     if(noise > 0)
         Error("Noise term not implemented for svd");
@@ -213,7 +226,7 @@ svd(ITensor const& AA,
         {
         //Try to determine current m,
         //then set mindim_ and maxdim_ to this.
-        args.add("Cutoff",-1);
+        args.add(Cutoff,-1);
         long mindim = 1,
              maxdim = MAX_DIM;
         if(D.order() == 0)
@@ -228,8 +241,8 @@ svd(ITensor const& AA,
             {
             mindim = maxdim = dim(D.inds().front());
             }
-        args.add("MinDim",mindim);
-        args.add("MaxDim",maxdim);
+        args.add(MinDim,mindim);
+        args.add(MaxDim,maxdim);
         }
 
     //auto ui = commonIndex(AAcomb,Ucomb);
@@ -308,7 +321,9 @@ truncate(Vector & P,
          bool doRelCutoff,
          Args const& args)
     {
-    auto respectDegenerate = args.getBool("RespectDegenerate",false);
+    static const auto RespectDegenerate = ArgName("RespectDegenerate");
+
+    auto respectDegenerate = args.getBool(RespectDegenerate,false);
 
     long origm = P.size();
     long n = origm-1;
@@ -725,6 +740,8 @@ diagPosSemiDef(ITensor const& M,
                ITensor      & D,
                Args args)
     {
+    PROFILE_REGION("diagHermitian");
+    auto mem_scope = MemoryScope("factorize");
     if(!args.defined("Tags")) args.add("Tags","Link");
 
     //
@@ -817,6 +834,7 @@ eigen(ITensor const& T,
       ITensor & D,
       Args args)
     {
+    PROFILE_REGION("eigen");
     if(!args.defined("Tags")) args.add("Tags","Link");
     auto colinds = std::vector<Index>{};
     for(auto& I : T.inds())
@@ -825,19 +843,11 @@ eigen(ITensor const& T,
         }
     auto [comb,cind] = combiner(std::move(colinds),args);
 
+    // If Tc is ordered {cind,prime(cind)}, eigDecompImpl
+    // works with the transpose of its data instead of
+    // permuting it
     auto Tc = prime(dag(comb)) * T * comb; 
 
-    // The version where Tc is ordered
-    // {cind,prime(cind)} does not work,
-    // here we will explicitly permute the
-    // ITensor so the indices are ordered
-    // {prime(cind),cind}.
-    // This is not great since it is an
-    // extra reordering of the data,
-    // look into fixing eigen properly.
-    if(inds(Tc)(1) != prime(cind))
-      Tc = permute(Tc,{prime(cind),cind});
-
     ITensor L;
     Index eigvec_ind;
     if(isComplex(T))
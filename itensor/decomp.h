@@ -279,35 +279,45 @@ denmatDecomp(ITensor const& AA,
              BigMatrixT const& PH,
              Args args)
     {
-    if( args.defined("Minm") )
+    static const auto Minm = ArgName("Minm");
+    static const auto MinDim = ArgName("MinDim");
+    static const auto Maxm = ArgName("Maxm");
+    static const auto MaxDim = ArgName("MaxDim");
+    static const auto Tags = ArgName("Tags");
+    static const auto Noise = ArgName("Noise");
+    static const auto UseOrigM = ArgName("UseOrigM");
+    static const auto Cutoff = ArgName("Cutoff");
+    static const auto TraceReIm = ArgName("TraceReIm");
+
+    if( args.defined(Minm) )
       {
-      if( args.defined("MinDim") )
+      if( args.defined(MinDim) )
         {
         Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
+        args.add(MinDim,args.getInt(Minm));
         }
       }
 
-    if( args.defined("Maxm") )
+    if( args.defined(Maxm) )
       {
-      if( args.defined("MaxDim") )
+      if( args.defined(MaxDim) )
         {
         Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
+        args.add(MaxDim,args.getInt(Maxm));
         }
       }
 
     //TODO: decide on a tag convention for denmatDecomp
-    if(!args.defined("Tags")) args.add("Tags","Link");
-    auto noise = args.getReal("Noise",0.);
+    if(!args.defined(Tags)) args.add(Tags,"Link");
+    auto noise = args.getReal(Noise,0.);
 
     //TODO: try to avoid using "Link" here
     auto mid = commonIndex(A,B);
@@ -351,14 +361,14 @@ denmatDecomp(ITensor const& AA,
         }
 
 
-    if(args.getBool("UseOrigM",false))
+    if(args.getBool(UseOrigM,false))
         {
-        args.add("Cutoff",-1);
-        args.add("MinDim",dim(mid));
-        args.add("MaxDim",dim(mid));
+        args.add(Cutoff,-1);
+        args.add(MinDim,dim(mid));
+        args.add(MaxDim,dim(mid));
         }
 
-    if(args.getBool("TraceReIm",false))
+    if(args.getBool(TraceReIm,false))
         rho = realPart(rho);
 
     ITensor U,D;
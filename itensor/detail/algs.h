@@ -22,6 +22,7 @@
 #include <ctime>
 #include <stdexcept>
 #include "itensor/types.h"
+#include "itensor/util/random.h"
 
 namespace itensor {
 namespace detail {
@@ -83,31 +84,18 @@ contains(const Container& C,
     return false;
     }
 
-//Simple linear congruential random number generator
-inline int&
+//Reseeds the random numbers (see util/random.h)
+//if newseed != 0; returns the current seed
+inline int
 seed_quickran(int newseed)
     {
-    static int seed = (std::time(NULL) + getpid());
-    if(newseed != 0) seed = newseed;
-    return seed;
+    if(newseed != 0) setRandomSeed(newseed);
+    return int(randomSeed());
     }
 
+//Uniform random number in [0,1)
 double inline
-quickran() 
-    {
-    auto res = 0.0;
-    while(res == 0.0)
-        {
-        auto& seed = seed_quickran(0);
-        int im = 134456;
-        int ia = 8121;
-        int ic = 28411;
-        double scale = 1.0 / im;
-        seed = (seed*ia+ic)%im;
-        res = std::fabs(double(seed)) * scale;
-        }
-    return res;
-    }
+quickran() { return randomReal(); }
 
 Cplx inline
 quickranCplx() { return Cplx(detail::quickran(),detail::quickran()); }
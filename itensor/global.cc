@@ -68,27 +68,16 @@ Global::showIDs()
 Real
 Global::random(int seed)
     {
-    using Generator = std::mt19937;
-    using Distribution = std::uniform_real_distribution<Real>;
-
-    static Generator rng(std::time(NULL)+getpid());
-    static Distribution dist(0,1);
-
-    if(seed != 0)  //reseed rng
-        {
-        rng = Generator(seed);
-        }
-
-    return dist(rng);
+    if(seed != 0) setRandomSeed(seed);
+    return randomReal();
     }
 void
 Global::warnDeprecated(const std::string& message)
     {
-    static int depcount = 1;
-    if(depcount <= 10)
+    static std::atomic<int> depcount(1);
+    if(depcount.fetch_add(1) <= 10)
         {
         println("\n\n",message,"\n");
-        ++depcount;
         }
     }
 bool&
@@ -97,4 +86,14 @@ Global::read32BitIDs()
     static bool read32_ = false;
     return read32_;
     }
+
+namespace detail {
+int&
+printDataOverride()
+    {
+    thread_local int pdat = -1;
+    return pdat;
+    }
+} //namespace detail
+
 } //namespace itensor
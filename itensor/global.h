@@ -16,6 +16,7 @@
 #ifndef __ITENSOR_GLOBAL_H
 #define __ITENSOR_GLOBAL_H
 
+#include <atomic>
 #include <cstdlib>
 #include <string>
 #include <cstring>
@@ -26,8 +27,10 @@
 #include "itensor/util/iterate.h"
 #include "itensor/util/error.h"
 #include "itensor/util/args.h"
+#include "itensor/util/random.h"
 #include "itensor/real.h"
 #include "itensor/util/timers.h"
+#include "itensor/util/set_scoped.h"
 #include "itensor/detail/algs.h"
 
 namespace itensor {
@@ -100,6 +103,9 @@ const int MAX_TAGS = 4;
 enum Printdat { ShowData, HideData };
 
 
+//The settings below are shared by all threads. The
+//library only reads them, so set them before starting
+//threads that use ITensor (or while none are running).
 class Global
     {
     public:
@@ -116,6 +122,14 @@ class Global
     static bool& read32BitIDs();
     };
 
+namespace detail {
+//Set by PrintEither for the calling thread only:
+//-1 defers to Global::printdat(), 0 hides and
+//1 shows tensor data
+int&
+printDataOverride();
+} //namespace detail
+
 #define PrintData(X) PrintEither(true,#X,X)
 #define PrintDat(X)  PrintEither(true,#X,X)
 
@@ -125,17 +139,16 @@ PrintEither(bool pdat,
             const char* tok,
             T const& X)
     {
-    auto savep = Global::printdat();
-    Global::printdat() = pdat;
+    SET_SCOPED(detail::printDataOverride()) = pdat ? 1 : 0;
     PrintNice(tok,X);
-    Global::printdat() = savep;
     }
 
+//Seed the random numbers used by Global::random,
+//randomize, randomITensor, randomMPS etc.
 void inline
 seedRNG(int seed)
     {
-    Global::random(seed);
-    detail::seed_quickran(seed);
+    setRandomSeed(seed);
     }
 
 } //namespace itensor
@@ -80,6 +80,9 @@ diagHImpl(ITensor H,
     auto absoluteCutoff = args.getBool("AbsoluteCutoff",false);
     auto showeigs = args.getBool("ShowEigs",false);
     auto itagset = getTagSet(args,"Tags","Link");
+    //If truncating, first compute only the eigenvalues,
+    //then only the eigenvectors which survive truncation
+    auto partial = do_truncate && args.getBool("PartialEigen",true);
 
     // If no truncation is occuring, reset MaxDim
     // to the full matrix dimension
@@ -122,8 +125,15 @@ diagHImpl(ITensor H,
         Vector DD;
         Mat<T> UU,iUU;
         auto R = toMatRefc<T>(H,active,prime(active));
-        diagHermitian(R,UU,DD);
-        conjugate(UU);
+        if(partial)
+            {
+            eigvalsHermitian(R,DD);
+            }
+        else
+            {
+            diagHermitian(R,UU,DD);
+            conjugate(UU);
+            }
 
         //Truncate
         Real truncerr = 0.0;
@@ -136,7 +146,16 @@ diagHImpl(ITensor H,
             //if(DD(1) < 0) DD *= -1; //DEBUG
             tie(truncerr,docut_lower,docut_upper,ndegen) = truncate(DD,maxdim,mindim,cutoff,absoluteCutoff,doRelCutoff,args);
             m = DD.size();
-            reduceCols(UU,m);
+            if(partial)
+                {
+                auto dd = Vector{};
+                diagHermitian(R,UU,dd,m);
+                conjugate(UU);
+                }
+            else
+                {
+                reduceCols(UU,m);
+                }
             }
 
         if(m > maxdim)
@@ -211,11 +230,13 @@ diagHImpl(ITensor H,
         for(auto b : range(Nblock))
             {
             totaldsize += nrows(blocks[b].M);
-            totalUsize += nrows(blocks[b].M)*ncols(blocks[b].M);
+            if(not partial) totalUsize += nrows(blocks[b].M)*ncols(blocks[b].M);
             }
 
         auto Udata = vector<T>(totalUsize);
         auto Umats = vector<MatRef<T>>(Nblock);
+        //Storage for eigenvectors computed after truncation
+        auto Upart = vector<Mat<T>>(partial ? Nblock : 0);
 
         auto ddata = vector<Real>(totaldsize);
         auto dvecs = vector<VectorRef>(Nblock);
@@ -226,6 +247,8 @@ diagHImpl(ITensor H,
 
         //1. Diagonalize each ITensor within H.
         //   Store results in mmatrix and mvector.
+        //   If partial, only compute eigenvalues here
+        //   so they can be truncated globally first.
         totaldsize = 0;
         totalUsize = 0;
         for(auto b : range(Nblock))
@@ -237,10 +260,17 @@ diagHImpl(ITensor H,
                  cM = ncols(M);
 
             d = makeVecRef(ddata.data()+totaldsize,rM);
-            UU = makeMatRef(Udata.data()+totalUsize,rM*cM,rM,cM);
-
-            diagHermitian(M,UU,d);
-            conjugate(UU);
+            if(partial)
+                {
+                eigvalsHermitian(M,d);
+                }
+            else
+                {
+                UU = makeMatRef(Udata.data()+totalUsize,rM*cM,rM,cM);
+                diagHermitian(M,UU,d);
+                conjugate(UU);
+                totalUsize += rM*cM;
+                }
 
             alleig.insert(alleig.end(),d.begin(),d.end());
             if(compute_qns)
@@ -253,7 +283,6 @@ diagHImpl(ITensor H,
                     }
                 }
             totaldsize += rM;
-            totalUsize += rM*cM;
             }
 
 
@@ -352,7 +381,18 @@ diagHImpl(ITensor H,
                 }
 
             d = subVector(d,0,this_m);
-            UU = columns(UU,0,this_m);
+            if(partial)
+                {
+                auto& UP = Upart.at(b);
+                auto dd = Vector{};
+                diagHermitian(B.M,UP,dd,this_m);
+                conjugate(UP);
+                UU = makeRef(UP);
+                }
+            else
+                {
+                UU = columns(UU,0,this_m);
+                }
 
             iq.emplace_back(qn(ai,1+B.i1),this_m);
             }
@@ -378,10 +418,10 @@ diagHImpl(ITensor H,
             auto& B = blocks[b];
             auto& UU = Umats.at(b);
             auto& dv = dvecs.at(b);
-            auto mm = ncols(UU);
             //Default-constructed B.M corresponds
             //to this_m==0 case above
             if(not B.M) continue;
+            auto mm = ncols(UU);
 
             auto uind = Labels(2);
             uind[0] = B.i1;
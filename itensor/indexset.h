@@ -717,6 +717,17 @@ contractIS(IndexSet const& Lis,
            LabelT & Nind,
            bool sortResult = false);
 
+//Labels Nind of the indices Nis of an existing result
+//of contracting Lis and Ris (labeled by Lind and Rind)
+template<class LabelT>
+void
+resultLabels(IndexSet const& Lis,
+             LabelT const& Lind,
+             IndexSet const& Ris,
+             LabelT const& Rind,
+             IndexSet const& Nis,
+             LabelT & Nind);
+
 template<class LabelT>
 void
 contractISReplaceIndex(IndexSet const& Lis,
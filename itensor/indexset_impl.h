@@ -126,6 +126,31 @@ contractIS(IndexSet const& Lis,
     Nis.computeStrides();
     }
 
+template<class LabelT>
+void
+resultLabels(IndexSet const& Lis,
+             LabelT const& Lind,
+             IndexSet const& Ris,
+             LabelT const& Rind,
+             IndexSet const& Nis,
+             LabelT & Nind)
+    {
+    Nind.resize(Nis.order());
+    for(auto i : range(Nis.order()))
+        {
+        auto j = indexPosition(Lis,Nis[i]);
+        if(j >= 0)
+            {
+            Nind[i] = Lind[j];
+            }
+        else
+            {
+            j = indexPosition(Ris,Nis[i]);
+            Nind[i] = Rind[j];
+            }
+        }
+    }
+
 template<class LabelT>
 void
 contractISReplaceIndex(IndexSet const& Lis,
@@ -0,0 +1,276 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include "itensor/itdata/contracttrace.h"
+#include "itensor/itensor.h"
+
+namespace itensor {
+
+namespace detail {
+
+std::atomic<bool> tracing_on(false);
+
+//Written at the start of a trace file
+const char* const TraceHeader = "ITensorContractionTrace";
+int constexpr TraceVersion = 1;
+
+//The file is a sequence of entries, each starting with one of:
+//IndexEntry, followed by an Index (written once per distinct
+//index, ignoring prime level and arrow direction), or
+//ContractionEntry, followed by a TracedContraction whose
+//indices refer to earlier IndexEntry's by number
+char constexpr IndexEntry = 'I';
+char constexpr ContractionEntry = 'C';
+
+struct TraceFile
+    {
+    std::mutex mutex;
+    std::ofstream s;
+    //Numbers of the indices written so far
+    std::unordered_map<Index::id_type,std::vector<std::pair<TagSet,int>>> numbers;
+    int nindex = 0;
+    };
+
+TraceFile&
+traceFile()
+    {
+    static auto* f = new TraceFile();
+    return *f;
+    }
+
+template<typename V>
+bool constexpr
+isCplx() { return std::is_same<V,Cplx>::value; }
+
+int
+indexNumber(TraceFile& f, Index const& I)
+    {
+    auto& nums = f.numbers[I.id()];
+    for(auto& [ts,n] : nums) if(ts == tags(I)) return n;
+    nums.emplace_back(tags(I),f.nindex);
+    auto J = I;
+    J.noPrime();
+    itensor::write(f.s,IndexEntry);
+    itensor::write(f.s,J);
+    return f.nindex++;
+    }
+
+void
+writeInds(TraceFile& f, IndexSet const& is)
+    {
+    auto nums = std::vector<int>{};
+    for(auto& I : is) nums.push_back(indexNumber(f,I));
+    itensor::write(f.s,nums.size());
+    for(auto n : range(nums.size()))
+        {
+        itensor::write(f.s,nums[n]);
+        itensor::write(f.s,is[n].primeLevel());
+        itensor::write(f.s,static_cast<int>(is[n].dir()));
+        }
+    }
+
+IndexSet
+readInds(std::istream& s, std::vector<Index> const& indices)
+    {
+    auto N = itensor::read<size_t>(s);
+    auto inds = std::vector<Index>(N);
+    for(auto& I : inds)
+        {
+        auto n = itensor::read<int>(s);
+        auto plev = itensor::read<int>(s);
+        auto dir = itensor::read<int>(s);
+        if(n < 0 || size_t(n) >= indices.size()) Error("Invalid contraction trace");
+        I = indices[n];
+        I.setPrime(plev);
+        I.setDir(static_cast<Arrow>(dir));
+        }
+    return IndexSet(inds);
+    }
+
+void
+writeRecord(TracedContraction const& t)
+    {
+    auto& f = traceFile();
+    std::lock_guard<std::mutex> lock(f.mutex);
+    if(!f.s.is_open()) return;
+    //Write new indices before the entry
+    //of the contraction using them
+    for(auto& I : t.Ais) indexNumber(f,I);
+    for(auto& I : t.Bis) indexNumber(f,I);
+    itensor::write(f.s,ContractionEntry);
+    itensor::write(f.s,t.blocksparse);
+    itensor::write(f.s,t.Acplx);
+    itensor::write(f.s,t.Bcplx);
+    writeInds(f,t.Ais);
+    itensor::write(f.s,t.Aoffsets);
+    itensor::write(f.s,t.Asize);
+    writeInds(f,t.Bis);
+    itensor::write(f.s,t.Boffsets);
+    itensor::write(f.s,t.Bsize);
+    }
+
+bool
+readRecord(std::istream& s, 
+           std::vector<Index> & indices,
+           TracedContraction& t)
+    {
+    auto entry = char{};
+    while(true)
+        {
+        itensor::read(s,entry);
+        if(!s.good()) return false;
+        if(entry != IndexEntry) break;
+        indices.push_back(itensor::read<Index>(s));
+        }
+    if(entry != ContractionEntry) Error("Invalid contraction trace");
+    itensor::read(s,t.blocksparse);
+    itensor::read(s,t.Acplx);
+    itensor::read(s,t.Bcplx);
+    t.Ais = readInds(s,indices);
+    itensor::read(s,t.Aoffsets);
+    itensor::read(s,t.Asize);
+    t.Bis = readInds(s,indices);
+    itensor::read(s,t.Boffsets);
+    itensor::read(s,t.Bsize);
+    return !s.fail();
+    }
+
+} //namespace detail
+
+void
+startContractionTrace(std::string const& fname)
+    {
+    auto& f = detail::traceFile();
+        {
+        std::lock_guard<std::mutex> lock(f.mutex);
+        if(f.s.is_open()) f.s.close();
+        f.s.open(fname,std::ios::binary);
+        f.numbers.clear();
+        f.nindex = 0;
+        if(!f.s.good()) Error("Could not open file \"" + fname + "\" for writing");
+        itensor::write(f.s,std::string(detail::TraceHeader));
+        itensor::write(f.s,detail::TraceVersion);
+        }
+    detail::tracing_on.store(true);
+    }
+
+void
+stopContractionTrace()
+    {
+    detail::tracing_on.store(false);
+    auto& f = detail::traceFile();
+    std::lock_guard<std::mutex> lock(f.mutex);
+    if(f.s.is_open()) f.s.close();
+    }
+
+template<typename VA, typename VB>
+void
+traceContraction(IndexSet const& Ais, Dense<VA> const& A,
+                 IndexSet const& Bis, Dense<VB> const& B)
+    {
+    if(!contractionTracing()) return;
+    auto t = TracedContraction{};
+    t.Acplx = detail::isCplx<VA>();
+    t.Bcplx = detail::isCplx<VB>();
+    t.Ais = Ais;
+    t.Bis = Bis;
+    t.Asize = A.size();
+    t.Bsize = B.size();
+    detail::writeRecord(t);
+    }
+template void traceContraction(IndexSet const&, Dense<Real> const&, IndexSet const&, Dense<Real> const&);
+template void traceContraction(IndexSet const&, Dense<Real> const&, IndexSet const&, Dense<Cplx> const&);
+template void traceContraction(IndexSet const&, Dense<Cplx> const&, IndexSet const&, Dense<Real> const&);
+template void traceContraction(IndexSet const&, Dense<Cplx> const&, IndexSet const&, Dense<Cplx> const&);
+
+template<typename VA, typename VB>
+void
+traceContraction(IndexSet const& Ais, QDense<VA> const& A,
+                 IndexSet const& Bis, QDense<VB> const& B)
+    {
+    if(!contractionTracing()) return;
+    auto t = TracedContraction{};
+    t.blocksparse = true;
+    t.Acplx = detail::isCplx<VA>();
+    t.Bcplx = detail::isCplx<VB>();
+    t.Ais = Ais;
+    t.Bis = Bis;
+    t.Aoffsets = A.offsets;
+    t.Boffsets = B.offsets;
+    t.Asize = A.size();
+    t.Bsize = B.size();
+    detail::writeRecord(t);
+    }
+template void traceContraction(IndexSet const&, QDense<Real> const&, IndexSet const&, QDense<Real> const&);
+template void traceContraction(IndexSet const&, QDense<Real> const&, IndexSet const&, QDense<Cplx> const&);
+template void traceContraction(IndexSet const&, QDense<Cplx> const&, IndexSet const&, QDense<Real> const&);
+template void traceContraction(IndexSet const&, QDense<Cplx> const&, IndexSet const&, QDense<Cplx> const&);
+
+std::vector<TracedContraction>
+readContractionTrace(std::string const& fname)
+    {
+    auto s = std::ifstream(fname,std::ios::binary);
+    if(!s.good()) Error("Could not open file \"" + fname + "\" for reading");
+    auto header = std::string{};
+    itensor::read(s,header);
+    auto version = itensor::read<int>(s);
+    if(header != detail::TraceHeader || version != detail::TraceVersion)
+        {
+        Error("File \"" + fname + "\" is not a contraction trace");
+        }
+    auto res = std::vector<TracedContraction>{};
+    auto indices = std::vector<Index>{};
+    auto t = TracedContraction{};
+    while(detail::readRecord(s,indices,t)) res.push_back(t);
+    return res;
+    }
+
+namespace detail {
+
+ITensor
+makeTracedTensor(bool blocksparse,
+                 bool cplx,
+                 IndexSet const& is,
+                 BlockOffsets const& offsets,
+                 size_t size)
+    {
+    auto T = ITensor{};
+    if(blocksparse)
+        {
+        if(cplx) T = ITensor(is,QDenseCplx(offsets,size));
+        else     T = ITensor(is,QDenseReal(offsets,size));
+        }
+    else
+        {
+        if(cplx) T = ITensor(is,DenseCplx(size));
+        else     T = ITensor(is,DenseReal(size));
+        }
+    T.randomize({"Complex",cplx});
+    return T;
+    }
+
+} //namespace detail
+
+std::pair<ITensor,ITensor>
+makeTracedTensors(TracedContraction const& t)
+    {
+    return std::make_pair(detail::makeTracedTensor(t.blocksparse,t.Acplx,t.Ais,t.Aoffsets,t.Asize),
+                          detail::makeTracedTensor(t.blocksparse,t.Bcplx,t.Bis,t.Boffsets,t.Bsize));
+    }
+
+} //namespace itensor
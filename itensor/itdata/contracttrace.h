@@ -0,0 +1,102 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_CONTRACTTRACE_H
+#define __ITENSOR_CONTRACTTRACE_H
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include "itensor/indexset.h"
+#include "itensor/itdata/dense.h"
+#include "itensor/itdata/qdense.h"
+
+namespace itensor {
+
+class ITensor;
+
+//
+// Contraction trace
+//
+// While a trace is being recorded, every contraction of two
+// Dense or two QDense tensors appends a record of the
+// index sets and (for QDense) block structure of the
+// two tensors to the trace file. The data itself is
+// not recorded.
+//
+// A trace can be read back and each contraction
+// re-executed on random data with the same structure,
+// for example with the replaytrace tool in tools/, to
+// benchmark changes to the contraction code on the
+// contractions of a real calculation:
+//
+//    startContractionTrace("dmrg.trace");
+//    auto [energy,psi] = dmrg(H,psi0,sweeps);
+//    stopContractionTrace();
+//
+
+//Start appending contractions to the file fname
+//(overwritten if it exists)
+void
+startContractionTrace(std::string const& fname);
+
+//Stop recording and close the trace file
+void
+stopContractionTrace();
+
+namespace detail {
+extern std::atomic<bool> tracing_on;
+}
+
+bool inline
+contractionTracing() { return detail::tracing_on.load(std::memory_order_relaxed); }
+
+struct TracedContraction
+    {
+    bool blocksparse = false;
+    bool Acplx = false,
+         Bcplx = false;
+    IndexSet Ais,
+             Bis;
+    //Block offsets and storage sizes;
+    //offsets are empty for Dense storage
+    BlockOffsets Aoffsets,
+                 Boffsets;
+    size_t Asize = 0,
+           Bsize = 0;
+    };
+
+//Record a contraction if a trace is being recorded
+template<typename VA, typename VB>
+void
+traceContraction(IndexSet const& Ais, Dense<VA> const& A,
+                 IndexSet const& Bis, Dense<VB> const& B);
+
+template<typename VA, typename VB>
+void
+traceContraction(IndexSet const& Ais, QDense<VA> const& A,
+                 IndexSet const& Bis, QDense<VB> const& B);
+
+std::vector<TracedContraction>
+readContractionTrace(std::string const& fname);
+
+//Tensors with the index sets and block structure
+//of a traced contraction, filled with random data
+std::pair<ITensor,ITensor>
+makeTracedTensors(TracedContraction const& t);
+
+} //namespace itensor
+
+#endif
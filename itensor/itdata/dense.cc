@@ -22,6 +22,9 @@
 #include "itensor/tensor/contract.h"
 #include "itensor/tensor/lapack_wrap.h"
 #include "itensor/util/tensorstats.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/perfcounters.h"
+#include "itensor/itdata/contracttrace.h"
 
 namespace itensor {
 
@@ -256,6 +259,9 @@ doTask(Contract & C,
        Dense<T2> const& R,
        ManageStore & m)
     {
+    PROFILE_REGION("contract.dense");
+    auto perf = PerfScope(PerfContract);
+    if(contractionTracing()) traceContraction(C.Lis,L,C.Ris,R);
     //if(not C.needresult)
     //    {
     //    m.makeNewData<ITLazy>(C.Lis,m.parg1(),C.Ris,m.parg2());
@@ -276,38 +282,21 @@ doTask(Contract & C,
         }
     else
         {
-        Nind.resize(C.Nis.order());
-        for(auto i : range(C.Nis.order()))
-            {
-            auto j = indexPosition(C.Lis,C.Nis[i]);
-            if(j >= 0)
-                {
-                Nind[i] = Lind[j];
-                }
-            else
-                {
-                j = indexPosition(C.Ris,C.Nis[i]);
-                Nind[i] = Rind[j];
-                }
-            }
+        resultLabels(C.Lis,Lind,C.Ris,Rind,C.Nis,Nind);
         }
     auto tL = makeTenRef(L.data(),L.size(),&C.Lis);
     auto tR = makeTenRef(R.data(),R.size(),&C.Ris);
     auto rsize = dim(C.Nis);
-TIMER_START(40);
     // Create a Dense storage with undefined data, since it will be
     // overwritten anyway
     auto nd = m.makeNewData<Dense<common_type<T1,T2>>>(undef,rsize);
-TIMER_STOP(40);
     auto tN = makeTenRef(nd->data(),nd->size(),&(C.Nis));
 
 #ifdef COLLECT_TSTATS
     tstats(tL,Lind,tR,Rind,tN,Nind);
 #endif
 
-START_TIMER(41);
     contract(tL,Lind,tR,Rind,tN,Nind);
-STOP_TIMER(41);
 
 
 #ifdef USESCALE
@@ -319,6 +308,66 @@ template void doTask(Contract&,DenseCplx const&,DenseReal const&,ManageStore&);
 template void doTask(Contract&,DenseReal const&,DenseCplx const&,ManageStore&);
 template void doTask(Contract&,DenseCplx const&,DenseCplx const&,ManageStore&);
 
+template<typename T1,typename T2>
+void
+doTask(ContractInto & C,
+       Dense<T1> const& L,
+       Dense<T2> const& R)
+    {
+    auto* N = storagePtr<Dense<common_type<T1,T2>>>(C.Cdata);
+    if(!N || N->size() != dim(C.Nis)) return;
+    PROFILE_REGION("contract.dense");
+    auto perf = PerfScope(PerfContract);
+    if(contractionTracing()) traceContraction(C.Lis,L,C.Ris,R);
+    Labels Lind,
+           Rind,
+           Nind;
+    computeLabels(C.Lis,C.Lis.order(),C.Ris,C.Ris.order(),Lind,Rind);
+    resultLabels(C.Lis,Lind,C.Ris,Rind,C.Nis,Nind);
+    auto tL = makeTenRef(L.data(),L.size(),&C.Lis);
+    auto tR = makeTenRef(R.data(),R.size(),&C.Ris);
+    auto tN = makeTenRef(N->data(),N->size(),&C.Nis);
+    contract(tL,Lind,tR,Rind,tN,Nind,C.alpha,C.beta);
+    C.done = true;
+    }
+template void doTask(ContractInto&,DenseReal const&,DenseReal const&);
+template void doTask(ContractInto&,DenseCplx const&,DenseReal const&);
+template void doTask(ContractInto&,DenseReal const&,DenseCplx const&);
+template void doTask(ContractInto&,DenseCplx const&,DenseCplx const&);
+
+template<typename T1,typename T2>
+void
+doTask(Dot & D,
+       Dense<T1> const& A,
+       Dense<T2> const& B)
+    {
+    auto r = D.Ais.order();
+    auto dims = std::vector<long>(r),
+         Astrides = std::vector<long>(r),
+         Bstrides = std::vector<long>(r),
+         Bstr = std::vector<long>(r);
+    long str = 1;
+    for(auto j : range(r))
+        {
+        Bstr[j] = str;
+        str *= dim(D.Bis[j]);
+        }
+    str = 1;
+    for(auto j : range(r))
+        {
+        dims[j] = dim(D.Ais[j]);
+        Astrides[j] = str;
+        str *= dims[j];
+        Bstrides[j] = Bstr[indexPosition(D.Bis,D.Ais[j])];
+        }
+    D.result = dotStrided(A.data(),B.data(),dims,Astrides,Bstrides,D.nthread);
+    D.done = true;
+    }
+template void doTask(Dot&,DenseReal const&,DenseReal const&);
+template void doTask(Dot&,DenseCplx const&,DenseReal const&);
+template void doTask(Dot&,DenseReal const&,DenseCplx const&);
+template void doTask(Dot&,DenseCplx const&,DenseCplx const&);
+
 template<typename VL, typename VR>
 void
 doTask(NCProd& P,
@@ -415,17 +464,23 @@ permuteDense(Permutation const& P,
     auto bref = makeTenRef(dB.data(),dB.size(),&Bis);
     auto aref = makeTenRef(dA.data(),dA.size(),&Ais);
     bref &= permute(aref,P);
+    perfAddBytesPermuted(PerfPermute,sizeof(T)*dA.size());
     }
 
+//Permute directly from the (possibly shared) data 
+//of dA into new storage, instead of first making
+//a copy of dA to read from
 template<typename T>
 void
 doTask(Order const& O,
-       Dense<T> & dA)
+       Dense<T> const& dA,
+       ManageStore & m)
     {
-    auto dB = dA;
-    permuteDense(O.perm(),dB,O.is1(),dA,O.is2());
+    auto perf = PerfScope(PerfPermute);
+    auto nd = m.makeNewData<Dense<T>>(undef,dA.size());
+    permuteDense(O.perm(),dA,O.is1(),*nd,O.is2());
     }
-template void doTask(Order const&,Dense<Real> &);
-template void doTask(Order const&,Dense<Cplx> &); 
+template void doTask(Order const&,Dense<Real> const&,ManageStore &);
+template void doTask(Order const&,Dense<Cplx> const&,ManageStore &); 
 
 } // namespace itensor
@@ -37,6 +37,7 @@ class Dense
     public:
     using value_type = T;
     using storage_type = vector_no_init<value_type>;
+    using allocator_type = typename storage_type::allocator_type;
     using size_type = typename storage_type::size_type;
     using iterator = typename storage_type::iterator;
     using const_iterator = typename storage_type::const_iterator;
@@ -45,7 +46,7 @@ class Dense
     // Data members
     //
 
-    storage_type store;
+    storage_type store = storage_type(allocator_type(MemDense));
 
     //
     // Constructors
@@ -54,26 +55,30 @@ class Dense
     Dense() { }
 
     explicit
-    Dense(size_t size) : store(size) { std::fill(store.begin(),store.end(),0.); }
+    Dense(size_t size) : store(size,allocator_type(MemDense)) { std::fill(store.begin(),store.end(),0.); }
 
     explicit
-    Dense(UndefInitializer, size_t size) : store(size) { }
+    Dense(UndefInitializer, size_t size) : store(size,allocator_type(MemDense)) { }
 
     // This allows a Dense to be constructed from a std::vector.
     // TODO: Does this copy?
     explicit
     Dense(std::vector<value_type> const& v)
-      : store(v.begin(),v.end())
+      : store(v.begin(),v.end(),allocator_type(MemDense))
       { }
 
     Dense(size_t size, value_type val) 
-      : store(size,val)
+      : store(size,val,allocator_type(MemDense))
         { }
 
     template<typename InputIterator>
-    Dense(InputIterator b, InputIterator e) : store(b,e) { }
+    Dense(InputIterator b, InputIterator e) : store(b,e,allocator_type(MemDense)) { }
 
-    Dense(storage_type&& data) : store(std::move(data)) { }
+    Dense(storage_type&& data)
+      : store(std::move(data),allocator_type(MemDense))
+        { 
+        trackMemKind(store);
+        }
 
     //
     //std container like methods
@@ -218,6 +223,27 @@ doTask(GenerateIT<F,Cplx>& G, Dense<Cplx> & D)
     stdx::generate(D,G.f);
     }
 
+template<typename T>
+void
+doTask(RandomFill const& R, Dense<T> const& D, ManageStore & m)
+    {
+    if(R.cplx == isCplx(D))
+        {
+        auto *mD = m.modifyData(D);
+        R(mD->data(),mD->size());
+        }
+    else if(R.cplx)
+        {
+        auto *nD = m.makeNewData<DenseCplx>(D.size());
+        R(nD->data(),nD->size());
+        }
+    else
+        {
+        auto *nD = m.makeNewData<DenseReal>(D.size());
+        R(nD->data(),nD->size());
+        }
+    }
+
 
 Cplx 
 doTask(GetElt const& g, DenseReal const& d);
@@ -303,6 +329,18 @@ doTask(Contract & C,
        Dense<T2> const& R,
        ManageStore & m);
 
+template<typename T1,typename T2>
+void
+doTask(ContractInto & C,
+       Dense<T1> const& L,
+       Dense<T2> const& R);
+
+template<typename T1,typename T2>
+void
+doTask(Dot & D,
+       Dense<T1> const& A,
+       Dense<T2> const& B);
+
 template<typename T1, typename T2>
 void
 doTask(NCProd& NCP,
@@ -320,7 +358,8 @@ doTask(PlusEQ const& P,
 template<typename T>
 void
 doTask(Order const& P,
-       Dense<T> & dA);
+       Dense<T> const& dA,
+       ManageStore & m);
 
 template<typename T>
 void
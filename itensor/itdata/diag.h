@@ -32,11 +32,12 @@ class Diag
     public:
     using value_type = stdx::decay_t<T>;
     using storage_type = vector_no_init<value_type>;
+    using allocator_type = typename storage_type::allocator_type;
     using size_type = typename storage_type::size_type;
     using iterator = typename storage_type::iterator;
     using const_iterator = typename storage_type::const_iterator;
 
-    storage_type store;
+    storage_type store = storage_type(allocator_type(MemDiag));
     T val = 0;
     size_type length = 0;
 
@@ -51,13 +52,13 @@ class Diag
         { }
 
     Diag(size_t size)
-      : store(size,0),
+      : store(size,0,allocator_type(MemDiag)),
         length(size)
         { }
 
     template<typename InputIterator>
     Diag(InputIterator b, InputIterator e)
-      : store(b,e),
+      : store(b,e,allocator_type(MemDiag)),
         length(store.size())
         { }
 
@@ -65,20 +66,22 @@ class Diag
     // TODO: Does this copy?
     explicit
     Diag(std::vector<value_type> const& v)
-      : store(v.begin(),v.end()),
+      : store(v.begin(),v.end(),allocator_type(MemDiag)),
         length(store.size())
       { }
 
     explicit
     Diag(storage_type&& data)
-      : store(std::move(data)),
+      : store(std::move(data),allocator_type(MemDiag)),
         length(store.size())
-        { }
+        { 
+        trackMemKind(store);
+        }
 
     template<typename V>
     explicit
     Diag(Diag<V> const& D)
-      : store(D.begin(),D.end()),
+      : store(D.begin(),D.end(),allocator_type(MemDiag)),
         val(D.val),
         length(D.length)
         { }
@@ -224,7 +227,7 @@ doTask(PlusEQ const& P,
 template<typename T>
 void
 doTask(Order const& P,
-       Diag<T> & dA) { }
+       Diag<T> const& dA) { }
 
 template<typename N, typename T>
 void
@@ -17,6 +17,7 @@
 #define __ITENSOR_ITDATA_H
 
 #include <memory>
+#include <atomic>
 #include "itensor/types.h"
 #include "itensor/util/error.h"
 #include "itensor/util/timers.h"
@@ -28,6 +29,19 @@ struct ITData;
 
 using PData = std::shared_ptr<ITData>;
 
+//True if p is the only reference to its storage, so
+//it can be modified in place (copy-on-write). The
+//use count is read with a relaxed load; the fence
+//makes accesses by other threads through copies they
+//have since released happen before our writes.
+bool inline
+isUniqueOwner(PData const& p)
+    {
+    if(p.use_count() != 1) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+    }
+
 struct CPData  //logically const ITData smart pointer
     {
     PData& p;
@@ -122,6 +136,15 @@ class ITWrap : public ITData
         }
     };
 
+//Pointer to the storage held by p if it has
+//type T, otherwise nullptr
+template<typename T>
+T*
+storagePtr(PData const& p)
+    {
+    auto* w = dynamic_cast<ITWrap<T>*>(p.get());
+    return w ? &(w->d) : nullptr;
+    }
 
 class ManageStore
     {
@@ -252,7 +275,7 @@ class ManageStore
         template<typename T>
         operator T&()
             {
-            if(!(pdata_->unique())) 
+            if(!isUniqueOwner(*pdata_)) 
                 {
                 auto* olda1 = static_cast<T*>(pdata_->get());
                 *pdata_ = std::make_shared<ITWrap<T>>(*olda1);
@@ -318,7 +341,7 @@ T* ManageStore::
 modifyData(const T& d)
     {
     //if(!pparg1_) Error("Can't modify const data");
-    if(!(pparg1_->unique())) 
+    if(!isUniqueOwner(*pparg1_)) 
         {
         auto* olda1 = static_cast<ITWrap<T>*>(pparg1_->get());
         *pparg1_ = std::make_shared<ITWrap<T>>(olda1->d);
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <map>
 //#include "itensor/util/iterate.h"
 #include "itensor/detail/gcounter.h"
 #include "itensor/detail/algs.h"
@@ -23,6 +24,9 @@
 #include "itensor/itdata/qdense.h"
 #include "itensor/itdata/qutil.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/perfcounters.h"
+#include "itensor/itdata/contracttrace.h"
 
 using std::vector;
 using std::move;
@@ -656,6 +660,280 @@ template void doTask(PlusEQ const&, QDense<Cplx> const&, QDense<Real> const&, Ma
 template void doTask(PlusEQ const&, QDense<Cplx> const&, QDense<Cplx> const&, ManageStore&);
 
 
+namespace detail {
+
+//Check if the contracted indices (negative labels) 
+//are contiguous and at the front or back, so that
+//blocks can be treated as matrices without permuting
+bool
+isMatrixLike(Labels const& ind)
+    {
+    auto r = long(ind.size());
+    long first = r,
+         last = -1;
+    for(auto i : range(r))
+        if(ind[i] < 0)
+            {
+            first = std::min(first,i);
+            last = i;
+            }
+    if(last < 0) return true;
+    for(auto i = first; i <= last; ++i)
+        if(ind[i] > 0) return false;
+    return first == 0 || last == r-1;
+    }
+
+//Permutation bringing the contracted indices to the 
+//front, in the order they appear in cont, keeping the
+//uncontracted indices in their original order
+Permutation
+contractedToFront(Labels const& ind,
+                  Labels const& cont)
+    {
+    auto r = long(ind.size());
+    auto P = Permutation(r);
+    long n = 0;
+    for(auto c : cont)
+        if(c < 0) P.setFromTo(find_index(ind,c),n++);
+    for(auto i : range(r))
+        if(ind[i] > 0) P.setFromTo(i,n++);
+    return P;
+    }
+
+//Number of elements of the block of a QDense 
+//tensor with indices is
+long
+blockSize(IndexSet const& is,
+          Block const& b)
+    {
+    long size = 1;
+    for(auto j : range(b)) size *= is[j].blocksize0(b[j]);
+    return size;
+    }
+
+//Mark in used the blocks of d that appear in the
+//block contractions; returns true if permuting each of
+//these blocks once moves fewer elements than permuting
+//a block for every block contraction that uses it
+template<typename T, typename GetBlock>
+bool
+prePermuteCheaper(QDense<T> const& d,
+                  IndexSet const& is,
+                  std::vector<std::tuple<Block,Block,Block>> const& blockContractions,
+                  GetBlock const& getblock,
+                  std::vector<bool> & used)
+    {
+    used.assign(d.offsets.size(),false);
+    long once = 0,
+         every = 0;
+    for(auto const& bc : blockContractions)
+        {
+        auto const& b = getblock(bc);
+        auto loc = getBlockLoc(d,b);
+        auto size = blockSize(is,b);
+        every += size;
+        if(!used[loc]) once += size;
+        used[loc] = true;
+        }
+    return every > once;
+    }
+
+//Permute the blocks of dA marked in used (see 
+//permuteQDense) into dB, leaving out the other blocks
+template<typename T>
+void
+permuteUsedBlocks(Permutation const& P,
+                  QDense<T> const& dA,
+                  IndexSet const& Ais,
+                  std::vector<bool> const& used,
+                  QDense<T> & dB,
+                  IndexSet & Bis)
+    {
+    auto perf = PerfScope(PerfPermute);
+    auto r = order(Ais);
+    auto bind = IndexSetBuilder(r);
+    for(auto i : range(r))
+        bind.setIndex(P.dest(i),Ais[i]);
+    Bis = bind.build();
+
+    //Permuted blocks in sorted order, each with the 
+    //location of the block of dA it comes from
+    auto blocks = std::vector<std::pair<Block,size_t>>{};
+    for(auto loc : range(dA.offsets.size()))
+        {
+        if(!used[loc]) continue;
+        auto const& ablock = dA.offsets[loc].block;
+        auto bblock = Block(r);
+        for(auto j : range(r)) bblock[P.dest(j)] = ablock[j];
+        blocks.emplace_back(std::move(bblock),loc);
+        }
+    std::sort(blocks.begin(),blocks.end(),
+              [](auto const& a, auto const& b) { return a.first < b.first; });
+    auto offsets = BlockOffsets{};
+    long size = 0;
+    for(auto const& [bblock,loc] : blocks)
+        {
+        offsets.push_back(make_blof(bblock,size));
+        size += blockSize(Bis,bblock);
+        }
+    dB = QDense<T>(undef,offsets,size);
+
+    Range Arange,
+          Brange;
+    for(auto const& [bblock,loc] : blocks)
+        {
+        auto const& aio = dA.offsets[loc];
+        Arange.init(make_indexdim(Ais,aio.block));
+        Brange.init(make_indexdim(Bis,bblock));
+        auto bref = makeRef(getBlock(dB,Bis,bblock),&Brange);
+        auto aref = makeTenRef(dA.data(),aio.offset,dA.size(),&Arange);
+        bref &= permute(aref,P);
+        }
+    perfAddBytesPermuted(PerfPermute,sizeof(T)*size);
+    }
+
+//Storage of a QDense tensor permuted once so that 
+//its contracted indices come first (see contractedToFront);
+//only the blocks used in the contraction are kept
+template<typename T>
+struct PrePermuted
+    {
+    QDense<T> const* d = nullptr;
+    IndexSet const* is = nullptr;
+    Labels ind;
+    Permutation P;
+    QDense<T> pd;
+    IndexSet pis;
+
+    PrePermuted(QDense<T> const& d_,
+                IndexSet const& is_,
+                Labels const& ind_)
+      : d(&d_), is(&is_), ind(ind_)
+        { }
+
+    explicit operator bool() const { return bool(P); }
+
+    void
+    permute(Labels const& cont,
+            std::vector<bool> const& used)
+        {
+        P = contractedToFront(ind,cont);
+        permuteUsedBlocks(P,*d,*is,used,pd,pis);
+        auto pind = ind;
+        for(auto i : range(ind.size())) pind[P.dest(i)] = ind[i];
+        ind = pind;
+        d = &pd;
+        is = &pis;
+        }
+
+    Block
+    block(Block const& b) const
+        {
+        if(!P) return b;
+        auto pb = b;
+        for(auto j : range(b)) pb[P.dest(j)] = b[j];
+        return pb;
+        }
+    };
+
+//C = alpha*A*B + beta*C for the given block contractions,
+//where C has the blocks of the result
+template<typename VA, typename VB>
+void
+contractBlocks(QDense<VA> const& A,
+               IndexSet const& Ais,
+               Labels const& Lind,
+               QDense<VB> const& B,
+               IndexSet const& Bis,
+               Labels const& Rind,
+               QDense<common_type<VA,VB>> & C,
+               IndexSet const& Cis,
+               Labels const& Cind,
+               std::vector<std::tuple<Block,Block,Block>> const& blockContractions,
+               Real alpha,
+               Real beta)
+    {
+    //If the blocks of A or B can't be treated as matrices
+    //without permuting them and blocks are used in several 
+    //block contractions, permute the used blocks of A or B 
+    //once up front instead of in every block contraction
+    auto PA = PrePermuted<VA>(A,Ais,Lind);
+    auto PB = PrePermuted<VB>(B,Bis,Rind);
+    auto usedA = std::vector<bool>{},
+         usedB = std::vector<bool>{};
+    auto permA = !isMatrixLike(Lind)
+                 && prePermuteCheaper(A,Ais,blockContractions,[](auto& bc) -> Block const& { return std::get<0>(bc); },usedA);
+    auto permB = !isMatrixLike(Rind)
+                 && prePermuteCheaper(B,Bis,blockContractions,[](auto& bc) -> Block const& { return std::get<1>(bc); },usedB);
+    if(permA || permB)
+        {
+        PROFILE_REGION("contract.qdense.prepermute");
+        if(permA) PA.permute(permB ? Lind : Rind,usedA);
+        if(permB) PB.permute(PA.ind,usedB);
+        }
+
+    //Group the block contractions by the sizes of the
+    //A and B blocks, so that the index analysis and scratch
+    //space for permutations are set up once per group
+    //instead of once per pair of blocks
+    struct BlockGroup
+        {
+        Range Arange,
+              Brange,
+              Crange;
+        std::vector<BatchContraction<VA,VB>> batch;
+        std::vector<int> Cblocklocs;
+        };
+    auto groups = std::vector<BlockGroup>{};
+    auto groupOf = std::map<std::vector<size_t>,size_t>{};
+    auto key = std::vector<size_t>{};
+    for(auto const& [origAblockind,origBblockind,Cblockind] : blockContractions)
+        {
+        auto Ablockind = PA.block(origAblockind);
+        auto Bblockind = PB.block(origBblockind);
+        auto Adims = make_indexdim(*PA.is,Ablockind);
+        auto Bdims = make_indexdim(*PB.is,Bblockind);
+        key.clear();
+        for(auto j : range(Adims.size())) key.push_back(Adims[j]);
+        for(auto j : range(Bdims.size())) key.push_back(Bdims[j]);
+        auto it = groupOf.find(key);
+        if(it == groupOf.end())
+            {
+            it = groupOf.emplace(key,groups.size()).first;
+            groups.emplace_back();
+            auto& g = groups.back();
+            g.Arange.init(Adims);
+            g.Brange.init(Bdims);
+            g.Crange.init(make_indexdim(Cis,Cblockind));
+            }
+        auto& g = groups[it->second];
+        g.batch.emplace_back(getBlock(*PA.d,*PA.is,Ablockind).data(),
+                             getBlock(*PB.d,*PB.is,Bblockind).data(),
+                             getBlock(C,Cis,Cblockind).data());
+        g.Cblocklocs.push_back(getBlockLoc(C,Cblockind));
+        }
+
+    //Determines if the contraction in the list overwrites or
+    //adds to the data. The first contraction into each block
+    //of C (in the order they are executed) scales it by beta,
+    //overwriting it if beta is zero (as when the data starts
+    //uninitialized)
+    PROFILE_REGION("contract.qdense.blocks");
+    auto written = std::vector<bool>(C.offsets.size(),false);
+    for(auto& g : groups)
+        {
+        for(auto n : range(g.batch.size()))
+            {
+            auto loc = g.Cblocklocs[n];
+            g.batch[n].beta = written[loc] ? 1. : beta;
+            written[loc] = true;
+            }
+        contractBatch(g.Arange,PA.ind,g.Brange,PB.ind,g.Crange,Cind,g.batch,alpha);
+        }
+    }
+
+} //namespace detail
+
 template<typename VA, typename VB>
 void
 doTask(Contract& Con,
@@ -663,6 +941,9 @@ doTask(Contract& Con,
        QDense<VB> const& B,
        ManageStore& m)
     {
+    PROFILE_REGION("contract.qdense");
+    auto perf = PerfScope(PerfContract);
+    if(contractionTracing()) traceContraction(Con.Lis,A,Con.Ris,B);
     using VC = common_type<VA,VB>;
     Labels Lind,
            Rind;
@@ -674,61 +955,18 @@ doTask(Contract& Con,
     const bool sortResult = false;
     contractIS(Con.Lis,Lind,Con.Ris,Rind,Con.Nis,Cind,sortResult);
 
-TIMER_START(32);
     //Allocate storage for C
-    auto [Coffsets,Csize,blockContractions] = getContractedOffsets(A,Con.Lis,B,Con.Ris,Con.Nis);
-TIMER_STOP(32);
-TIMER_START(33);
+    auto [Coffsets,Csize,blockContractions] = [&]
+        {
+        PROFILE_REGION("contract.qdense.offsets");
+        return getContractedOffsets(A,Con.Lis,B,Con.Ris,Con.Nis);
+        }();
     // Create QDense storage with uninitialized memory, faster than
     // setting to zeros
     auto nd = m.makeNewData<QDense<VC>>(undef,Coffsets,Csize);
-TIMER_STOP(33);
     auto& C = *nd;
 
-    //Determines if the contraction in the list overwrites or
-    //adds to the data. Initially, overwrite the data since the
-    //data starts uninitialized
-    auto betas = std::vector<Real>(C.offsets.size(),0.);
-
-    //Function to execute for each pair of
-    //contracted blocks of A and B
-    auto do_contract = 
-        [&Con,&Lind,&Rind,&Cind,&betas]
-        (DataRange<const VA> ablock, Block const& Ablockind,
-         DataRange<const VB> bblock, Block const& Bblockind,
-         DataRange<VC>       cblock, Block const& Cblockind,
-         int Cblockloc)
-        {
-        Range Arange,
-              Brange,
-              Crange;
-        //Construct range objects for aref,bref,cref
-        //using IndexDim helper objects
-        Arange.init(make_indexdim(Con.Lis,Ablockind));
-        Brange.init(make_indexdim(Con.Ris,Bblockind));
-        Crange.init(make_indexdim(Con.Nis,Cblockind));
-
-        //"Wire up" TensorRef's pointing to blocks of A,B, and C
-        //we are working with
-        auto aref = makeRef(ablock,&Arange);
-        auto bref = makeRef(bblock,&Brange);
-        auto cref = makeRef(cblock,&Crange);
-
-        // cref += aref*bref or cref = aref*bref
-        contract(aref,Lind,bref,Rind,cref,Cind,1.,betas[Cblockloc]);
-
-        // If the block had not been called, betas[Cblockloc] == 0
-        // Set it to 1 after it has been called
-        betas[Cblockloc] = 1.;
-        };
-
-TIMER_START(34);
-    loopContractedBlocks(A,Con.Lis,
-                         B,Con.Ris,
-                         C,Con.Nis,
-                         blockContractions,
-                         do_contract);
-TIMER_STOP(34);
+    detail::contractBlocks(A,Con.Lis,Lind,B,Con.Ris,Rind,C,Con.Nis,Cind,blockContractions,1.,0.);
 
 #ifdef USESCALE
     Con.scalefac = computeScalefac(C);
@@ -739,6 +977,92 @@ template void doTask(Contract& Con,QDense<Cplx> const&,QDense<Real> const&,Manag
 template void doTask(Contract& Con,QDense<Real> const&,QDense<Cplx> const&,ManageStore&);
 template void doTask(Contract& Con,QDense<Cplx> const&,QDense<Cplx> const&,ManageStore&);
 
+template<typename VA, typename VB>
+void
+doTask(ContractInto& Con,
+       QDense<VA> const& A,
+       QDense<VB> const& B)
+    {
+    auto* C = storagePtr<QDense<common_type<VA,VB>>>(Con.Cdata);
+    if(!C) return;
+    PROFILE_REGION("contract.qdense");
+    Labels Lind,
+           Rind,
+           Cind;
+    computeLabels(Con.Lis,order(Con.Lis),Con.Ris,order(Con.Ris),Lind,Rind);
+    resultLabels(Con.Lis,Lind,Con.Ris,Rind,Con.Nis,Cind);
+
+    auto [Coffsets,Csize,blockContractions] = [&]
+        {
+        PROFILE_REGION("contract.qdense.offsets");
+        return getContractedOffsets(A,Con.Lis,B,Con.Ris,Con.Nis);
+        }();
+    auto sameBlocks = [](BlockOffsets const& x, BlockOffsets const& y)
+        {
+        if(x.size() != y.size()) return false;
+        for(auto n : range(x.size()))
+            {
+            if(x[n].block != y[n].block || x[n].offset != y[n].offset) return false;
+            }
+        return true;
+        };
+    if(size_t(Csize) != C->size() || !sameBlocks(Coffsets,C->offsets)) return;
+
+    auto perf = PerfScope(PerfContract);
+    if(contractionTracing()) traceContraction(Con.Lis,A,Con.Ris,B);
+    detail::contractBlocks(A,Con.Lis,Lind,B,Con.Ris,Rind,*C,Con.Nis,Cind,blockContractions,Con.alpha,Con.beta);
+    Con.done = true;
+    }
+template void doTask(ContractInto& Con,QDense<Real> const&,QDense<Real> const&);
+template void doTask(ContractInto& Con,QDense<Cplx> const&,QDense<Real> const&);
+template void doTask(ContractInto& Con,QDense<Real> const&,QDense<Cplx> const&);
+template void doTask(ContractInto& Con,QDense<Cplx> const&,QDense<Cplx> const&);
+
+template<typename VA, typename VB>
+void
+doTask(Dot & D,
+       QDense<VA> const& A,
+       QDense<VB> const& B)
+    {
+    auto r = D.Ais.order();
+    //Position in B of each index of A
+    auto AtoB = std::vector<long>(r);
+    for(auto j : range(r)) AtoB[j] = indexPosition(D.Bis,D.Ais[j]);
+    auto dims = std::vector<long>(r),
+         Astrides = std::vector<long>(r),
+         Bstrides = std::vector<long>(r),
+         Bstr = std::vector<long>(r);
+    auto Bblock = Block(r);
+    auto res = Cplx(0.);
+    for(auto const& aio : A.offsets)
+        {
+        for(auto j : range(r)) Bblock[AtoB[j]] = aio.block[j];
+        auto boff = offsetOf(B.offsets,Bblock);
+        if(boff < 0) continue;
+        long str = 1;
+        for(auto j : range(r))
+            {
+            Bstr[j] = str;
+            str *= D.Bis[j].blocksize0(Bblock[j]);
+            }
+        str = 1;
+        for(auto j : range(r))
+            {
+            dims[j] = D.Ais[j].blocksize0(aio.block[j]);
+            Astrides[j] = str;
+            str *= dims[j];
+            Bstrides[j] = Bstr[AtoB[j]];
+            }
+        res += dotStrided(A.data()+aio.offset,B.data()+boff,dims,Astrides,Bstrides,D.nthread);
+        }
+    D.result = res;
+    D.done = true;
+    }
+template void doTask(Dot&,QDense<Real> const&,QDense<Real> const&);
+template void doTask(Dot&,QDense<Cplx> const&,QDense<Real> const&);
+template void doTask(Dot&,QDense<Real> const&,QDense<Cplx> const&);
+template void doTask(Dot&,QDense<Cplx> const&,QDense<Cplx> const&);
+
 template<typename VA, typename VB>
 void
 doTask(NCProd& P,
@@ -845,6 +1169,7 @@ permuteQDense(Permutation  const& P,
               QDense<T>         & dB,
               IndexSet        & Bis)
     {
+    auto perf = PerfScope(PerfPermute);
     // Recalculate new indexset by permuting
     // original indexset (otherwise it segfaults)
     auto r = order(Ais);
@@ -871,19 +1196,21 @@ permuteQDense(Permutation  const& P,
 
         bref += permute(aref,P);
         }
+    perfAddBytesPermuted(PerfPermute,sizeof(T)*dA.size());
     }
 
 template<typename T>
 void
 doTask(Order const& O,
-       QDense<T> & dB)
+       QDense<T> const& dA,
+       ManageStore & m)
     {
-    auto const dA = dB;
     auto Bis = O.is2();
-    permuteQDense(O.perm(),dA,O.is1(),dB,Bis);
+    auto nd = m.makeNewData<QDense<T>>();
+    permuteQDense(O.perm(),dA,O.is1(),*nd,Bis);
     }
-template void doTask(Order const&,QDense<Real> &);
-template void doTask(Order const&,QDense<Cplx> &);
+template void doTask(Order const&,QDense<Real> const&,ManageStore &);
+template void doTask(Order const&,QDense<Cplx> const&,ManageStore &);
 
 template<typename V>
 TenRef<Range,V>
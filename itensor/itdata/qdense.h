@@ -39,6 +39,7 @@ class QDense
     public:
     using value_type = T;
     using storage_type = vector_no_init<value_type>;
+    using allocator_type = typename storage_type::allocator_type;
     using iterator = typename storage_type::iterator;
     using const_iterator = typename storage_type::const_iterator;
 
@@ -49,7 +50,7 @@ class QDense
         //  Assumed that block indices are
         //  in increasing order.
 
-    storage_type store;
+    storage_type store = storage_type(allocator_type(MemQDense));
         //^ tensor data stored contiguously
     //////////////
 
@@ -73,7 +74,7 @@ class QDense
     QDense(BlockOffsets const& off,
            size_t size)
          : offsets(off),
-           store(size)
+           store(size,allocator_type(MemQDense))
            {
            std::fill(store.begin(),store.end(),0.);
            }
@@ -81,7 +82,7 @@ class QDense
     QDense(BlockOffsets const& off,
            std::vector<value_type> const& v)
          : offsets(off),
-           store(v.begin(),v.end())
+           store(v.begin(),v.end(),allocator_type(MemQDense))
            {
            }
 
@@ -89,7 +90,7 @@ class QDense
     QDense(BlockOffsets const& off,
            InputIterator begin, InputIterator end)
      : offsets(off),
-       store(begin,end)
+       store(begin,end,allocator_type(MemQDense))
        {
        }
 
@@ -97,7 +98,7 @@ class QDense
            std::vector<BlOf> const& off,
            size_t size)
          : offsets(off),
-           store(size)
+           store(size,allocator_type(MemQDense))
            {
            }
 
@@ -312,6 +313,27 @@ doTask(GenerateIT<F,Cplx>& G, QDenseCplx & D)
     stdx::generate(D,G.f);
     }
 
+template<typename T>
+void
+doTask(RandomFill const& R, QDense<T> const& D, ManageStore & m)
+    {
+    if(R.cplx == isCplx(D))
+        {
+        auto *mD = m.modifyData(D);
+        R(mD->data(),mD->size());
+        }
+    else if(R.cplx)
+        {
+        auto *nD = m.makeNewData<QDenseCplx>(D.offsets,D.size());
+        R(nD->data(),nD->size());
+        }
+    else
+        {
+        auto *nD = m.makeNewData<QDenseReal>(D.offsets,D.size());
+        R(nD->data(),nD->size());
+        }
+    }
+
 
 Cplx
 doTask(GetElt& G, QDenseReal const& d);
@@ -410,6 +432,18 @@ doTask(Contract& Con,
        QDense<VB> const& B,
        ManageStore& m);
 
+template<typename VA, typename VB>
+void
+doTask(ContractInto& Con,
+       QDense<VA> const& A,
+       QDense<VB> const& B);
+
+template<typename VA, typename VB>
+void
+doTask(Dot & D,
+       QDense<VA> const& A,
+       QDense<VB> const& B);
+
 //TODO: complete implementation
 //template<typename VA, typename VB>
 //void
@@ -531,7 +565,8 @@ insertBlock(IndexSet const& is,
 template<typename T>
 void
 doTask(Order const& P,
-       QDense<T>           & dA);
+       QDense<T>      const& dA,
+       ManageStore         & m);
 
 template<typename T>
 void
@@ -539,7 +574,7 @@ permuteQDense(Permutation const& P,
               QDense<T>    const& dA,
               IndexSet   const& Ais,
               QDense<T>         & dB,
-              IndexSet   const& Bis);
+              IndexSet        & Bis);
 
 //template<typename BlockSparseStore, typename Indexable>
 //auto
@@ -245,7 +245,7 @@ doTask(Mult<Cplx> const& M, QDiag<Real> const& d, ManageStore & m)
     if(not d.allSame())
         {
         auto *nd = m.makeNewData<QDiagCplx>();
-        nd->store = QDiagCplx::storage_type(d.begin(),d.end());
+        nd->store.assign(d.begin(),d.end());
         }
     doTask(M,*nd);
     }
@@ -34,11 +34,12 @@ class QDiag
     public:
     using value_type = T;
     using storage_type = vector_no_init<value_type>;
+    using allocator_type = typename storage_type::allocator_type;
     using iterator = typename storage_type::iterator;
     using const_iterator = typename storage_type::const_iterator;
 
     //////////////
-    storage_type store;
+    storage_type store = storage_type(allocator_type(MemQDiag));
         //^ *diagonal* tensor elements stored contiguously
 
     T val = 0;
@@ -57,13 +58,13 @@ class QDiag
     template<typename V>
     explicit
     QDiag(QDiag<V> const& D)
-      : store(D.begin(),D.end()),
+      : store(D.begin(),D.end(),allocator_type(MemQDiag)),
         val(D.val),
         length(D.length)
         { }
 
     QDiag(size_t size)
-      : store(size,0.),
+      : store(size,0.,allocator_type(MemQDiag)),
         length(size)
         { }
 
@@ -231,6 +232,34 @@ doTask(GenerateIT<F,Cplx>& G, QDiagCplx & D)
     stdx::generate(D,G.f);
     }
 
+template<typename T>
+void
+doTask(RandomFill const& R, QDiag<T> const& D, ManageStore & m)
+    {
+    if(R.cplx == isCplx(D))
+        {
+        auto *mD = m.modifyData(D);
+        if(mD->allSame())
+            {
+            mD->val = 0;
+            mD->store.resize(mD->length);
+            }
+        R(mD->store.data(),mD->store.size());
+        }
+    else if(R.cplx)
+        {
+        auto *nD = m.makeNewData<QDiagCplx>();
+        nD->store.resize(D.length);
+        R(nD->store.data(),nD->store.size());
+        }
+    else
+        {
+        auto *nD = m.makeNewData<QDiagReal>();
+        nD->store.resize(D.length);
+        R(nD->store.data(),nD->store.size());
+        }
+    }
+
 template<typename T>
 Cplx
 doTask(SumEls, QDiag<T> const& d);
@@ -287,7 +316,7 @@ doTask(Contract& Con,
 template<typename T>
 void
 doTask(Order const& P,
-       QDiag<T> & dA) { }
+       QDiag<T> const& dA) { }
 
 template<typename Indexable>
 std::tuple<size_t,size_t,IntArray>
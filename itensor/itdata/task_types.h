@@ -18,8 +18,10 @@
 
 #include "itensor/util/infarray.h"
 #include "itensor/util/print.h"
+#include "itensor/util/random.h"
 #include "itensor/real.h"
 #include "itensor/indexset.h"
+#include "itensor/itdata/itdata.h"
 
 namespace itensor {
 
@@ -277,6 +279,23 @@ template<typename T>
 const char*
 typeNameOf(Fill<T> const&) { return "Fill"; }
 
+//Fill with uniform random numbers from stream
+//"stream" (see util/random.h), converting to complex
+//storage if cplx is true and to real otherwise
+struct RandomFill
+    {
+    bool cplx = false;
+    uint64_t stream = 0;
+    int nthread = 1;
+
+    template<typename T>
+    void
+    operator()(T* data, size_t size) const { randomFill(data,size,stream,nthread); }
+    };
+
+inline const char*
+typeNameOf(RandomFill const&) { return "RandomFill"; }
+
 struct TakeReal { };
 struct TakeImag { };
 struct MakeCplx { };
@@ -418,6 +437,77 @@ struct Contract
 inline const char*
 typeNameOf(Contract const&) { return "Contract"; }
 
+//C = alpha*L*R + beta*C, written into the existing
+//storage Cdata of C (with indices Nis). done is false,
+//and C unchanged, if Cdata does not have the type
+//and block structure of the product.
+struct ContractInto
+    {
+    IndexSet const& Lis;
+    IndexSet const& Ris;
+    IndexSet const& Nis;
+    PData const& Cdata;
+    Real alpha = 1.;
+    Real beta = 0.;
+    bool done = false;
+
+    ContractInto(IndexSet const& Lis_,
+                 IndexSet const& Ris_,
+                 IndexSet const& Nis_,
+                 PData const& Cdata_,
+                 Real alpha_ = 1.,
+                 Real beta_ = 0.)
+      : Lis(Lis_),
+        Ris(Ris_),
+        Nis(Nis_),
+        Cdata(Cdata_),
+        alpha(alpha_),
+        beta(beta_)
+        { }
+
+    ContractInto(ContractInto const& other) = delete;
+    ContractInto& operator=(ContractInto const& other) = delete;
+    ContractInto(ContractInto&& other) = default;
+    };
+
+inline const char*
+typeNameOf(ContractInto const&) { return "ContractInto"; }
+
+template<typename D1, typename D2>
+void
+doTask(ContractInto &, D1 const&, D2 const&) { }
+
+//Sum of conj(A)*B over all elements, for A and B
+//with the same indices Ais and Bis in any order.
+//done is false if not implemented for the storage types.
+struct Dot
+    {
+    IndexSet const& Ais;
+    IndexSet const& Bis;
+    int nthread = 1;
+    Cplx result = 0.;
+    bool done = false;
+
+    Dot(IndexSet const& Ais_,
+        IndexSet const& Bis_,
+        int nthread_ = 1)
+      : Ais(Ais_),
+        Bis(Bis_),
+        nthread(nthread_)
+        { }
+
+    Dot(Dot const& other) = delete;
+    Dot& operator=(Dot const& other) = delete;
+    Dot(Dot&& other) = default;
+    };
+
+inline const char*
+typeNameOf(Dot const&) { return "Dot"; }
+
+template<typename D1, typename D2>
+void
+doTask(Dot &, D1 const&, D2 const&) { }
+
 //Non-contracting product
 struct NCProd
     {
@@ -277,8 +277,13 @@ randomize(Args const& args)
     if(!(*this)) Error("default initialized tensor in randomize");
 #endif
     auto cplx = args.getBool("Complex",false);
-    if(cplx) this->generate(detail::quickranCplx);
-    else     this->generate(detail::quickran);
+    auto nthread = args.getInt("NThread",4);
+    fixBlockDeficient();
+    scaleTo(1);
+    //Each call fills from a new stream, so the result
+    //does not depend on the number of threads
+    auto stream = threadRandomStream().next64();
+    doTask(RandomFill{cplx,stream,int(nthread)},store_);
     return *this;
     }
 
@@ -758,6 +763,36 @@ norm(ITensor const& T)
 #endif
     }
 
+Cplx
+dotC(ITensor const& A,
+     ITensor const& B,
+     Args const& args)
+    {
+    if(!A || !B) Error("Default constructed ITensor in dotC");
+    if(!hasSameInds(A.inds(),B.inds()))
+        {
+        Error(format("dotC: ITensors must have the same indices, got\n%s\nand\n%s",A.inds(),B.inds()));
+        }
+    if(order(A) > 0 && hasQNs(A) == hasQNs(B))
+        {
+        static const auto NThread = ArgName("NThread");
+        auto D = doTask(Dot{A.inds(),B.inds(),static_cast<int>(args.getInt(NThread,4))},
+                        A.store(),
+                        B.store());
+        if(D.done) return D.result;
+        }
+    return eltC(dag(A)*B);
+    }
+
+Real
+dot(ITensor const& A,
+    ITensor const& B,
+    Args const& args)
+    {
+    if(isComplex(A) || isComplex(B)) Error("Cannot use dot(...) with complex ITensors, use dotC(...) instead");
+    return dotC(A,B,args).real();
+    }
+
 void ITensor::
 write(std::ostream& s) const
     {
@@ -1068,6 +1103,73 @@ operator/(ITensor A, ITensor const& B) { A /= B; return A; }
 ITensor
 operator/(ITensor const& A, ITensor && B) { B /= A; return std::move(B); }
 
+namespace detail {
+
+//Check that Nis holds the uncontracted indices
+//of Lis and Ris (in any order, with the same arrows)
+bool
+isContractionResult(IndexSet const& Nis,
+                    IndexSet const& Lis,
+                    IndexSet const& Ris)
+    {
+    long nuniq = 0;
+    for(auto& l : Lis) if(indexPosition(Ris,l) < 0) ++nuniq;
+    for(auto& r : Ris) if(indexPosition(Lis,r) < 0) ++nuniq;
+    if(nuniq != long(Nis.order())) return false;
+    for(auto& n : Nis)
+        {
+        auto jl = indexPosition(Lis,n);
+        auto jr = indexPosition(Ris,n);
+        if(jl >= 0 && jr < 0 && Lis[jl].dir() == n.dir()) continue;
+        if(jr >= 0 && jl < 0 && Ris[jr].dir() == n.dir()) continue;
+        return false;
+        }
+    return true;
+    }
+
+} //namespace detail
+
+void
+contractInto(ITensor const& A,
+             ITensor const& B,
+             ITensor & C,
+             Real alpha,
+             Real beta)
+    {
+    if(!A || !B) Error("Default constructed ITensor in contractInto");
+
+    if(C && order(A) > 0 && order(B) > 0
+       && hasQNs(A) == hasQNs(B) && hasQNs(C) == hasQNs(A)
+       && detail::isContractionResult(C.inds(),A.inds(),B.inds()))
+        {
+        if(Global::checkArrows()) detail::checkArrows(A.inds(),B.inds());
+        //If the storage of C is shared (including with A or B)
+        //it must be copied first, which is only worth it
+        //if the old values are used
+        auto& Cstore = C.store();
+        auto shared = (&C == &A || &C == &B || !isUniqueOwner(Cstore));
+        if(!shared || beta != 0.)
+            {
+            if(shared) Cstore = Cstore->clone();
+            auto CI = doTask(ContractInto{A.inds(),B.inds(),C.inds(),Cstore,alpha,beta},
+                             A.store(),
+                             B.store());
+            if(CI.done) return;
+            }
+        }
+
+    if(beta == 0. || !C)
+        {
+        C = A*B;
+        if(alpha != 1.) C *= alpha;
+        }
+    else
+        {
+        C *= beta;
+        C += alpha*(A*B);
+        }
+    }
+
 // Create some sparse tensors to help with
 // a partial direct sum
 Index
@@ -1240,7 +1342,7 @@ multSiteOps(ITensor A, ITensor const& B)
     {
     A.prime("Site");
     A *= B;
-    A.replaceTags("2","1","Site");
+    A.mapPrime(2,1,"Site");
     return A;
     }
 
@@ -1328,7 +1430,8 @@ operator<<(ostream & s, ITensor const& t)
         //printing the contents of an ITensor when using the printf
         //format string %f (or another float-related format string)
         bool ff_set = (std::ios::floatfield & s.flags()) != 0;
-        bool print_data = (ff_set || Global::printdat());
+        auto pdat = detail::printDataOverride();
+        bool print_data = ff_set || (pdat < 0 ? Global::printdat() : pdat == 1);
         doTask(PrintIT{s,t.scale(),inds(t),print_data},t.store());
         }
     return s;
@@ -1573,7 +1676,7 @@ randomITensor(QN q, IndexSet const& is)
     ITensor T;
     auto dat = QDenseReal{is,q};
     T = ITensor(std::move(is),std::move(dat));
-    T.generate(detail::quickran);
+    T.randomize();
     return T;
     }
 
@@ -1587,7 +1690,7 @@ randomITensorC(QN q, IndexSet const& is)
     ITensor T;
     auto dat = QDenseCplx{is,q};
     T = ITensor(std::move(is),std::move(dat));
-    T.generate(detail::quickranCplx);
+    T.randomize({"Complex=",true});
     return T;
     }
 
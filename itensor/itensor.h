@@ -142,6 +142,10 @@ class ITensor
     void
     set(std::vector<int> const& ivs, Cplx val);
 
+    //Set elements to uniform random numbers in [0,1)
+    //Args: "Complex" (default false); "NThread" (default 4),
+    //threads used for large tensors (the result does not
+    //depend on the number of threads)
     ITensor&
     randomize(Args const& args = Args::global());
 
@@ -546,6 +550,25 @@ operator/(ITensor A, ITensor const& B);
 ITensor
 operator/(ITensor const& A, ITensor && B);
 
+//
+// Contract A and B into C: C = alpha*A*B + beta*C
+//
+// If C already has the indices (in any order), storage
+// type and, for QN ITensors, the blocks of the product,
+// the result is written into the storage of C without
+// allocating. Otherwise a new product is computed and
+// C is replaced by it (if beta is zero or C is default
+// constructed) or it is added to beta*C.
+// Useful for reusing buffers in loops whose
+// contractions have the same indices every time.
+//
+void
+contractInto(ITensor const& A,
+             ITensor const& B,
+             ITensor & C,
+             Real alpha = 1.,
+             Real beta = 0.);
+
 // Partial direct sum of ITensors A and B
 // over the specified indices
 std::tuple<ITensor,IndexSet>
@@ -850,6 +873,23 @@ order(ITensor const& T);
 Real
 norm(ITensor const& T);
 
+//Inner product of A and B, which must have the same
+//indices (in any order; arrows are ignored).
+//Result is equivalent to eltC(dag(A)*B) but computed
+//directly on the storage, without a general contraction.
+//Args: "NThread" (default 4) - threads used for very
+//      large tensors
+Cplx
+dotC(ITensor const& A,
+     ITensor const& B,
+     Args const& args = Args::global());
+
+//Real version of dotC, for real A and B
+Real
+dot(ITensor const& A,
+    ITensor const& B,
+    Args const& args = Args::global());
+
 ITensor
 random(ITensor T, Args const& args = Args::global());
 
@@ -18,10 +18,21 @@
 #include "itensor/util/iterate.h"
 #include "itensor/itensor.h"
 #include "itensor/tensor/algs.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/memory_usage.h"
 
 
 namespace itensor {
 
+//
+// Convergence information of a call to davidson
+//
+struct DavidsonInfo
+    {
+    size_t iterations = 0; //number of iterations performed
+    Real residual = NAN;   //norm of the last residual vector
+    };
+
 //
 // Use the Davidson algorithm to find the 
 // eigenvector of the Hermitian matrix A with minimal eigenvalue.
@@ -35,6 +46,14 @@ davidson(BigMatrixT const& A,
          ITensor& phi,
          Args const& args = Args::global());
 
+//Same as above, also filling info
+template <class BigMatrixT>
+Real 
+davidson(BigMatrixT const& A, 
+         ITensor& phi,
+         DavidsonInfo& info,
+         Args const& args = Args::global());
+
 //
 // Use Davidson to find the N eigenvectors with smallest 
 // eigenvalues of the Hermitian matrix A, given a vector of N 
@@ -49,6 +68,13 @@ davidson(BigMatrixT const& A,
          std::vector<ITensor>& phi,
          Args const& args = Args::global());
 
+template <class BigMatrixT>
+std::vector<Real>
+davidson(BigMatrixT const& A, 
+         std::vector<ITensor>& phi,
+         DavidsonInfo& info,
+         Args const& args = Args::global());
+
 //
 // Use GMRES to iteratively solve A x = b for x.
 // (BigMatrixT objects must implement the methods product and size.)
@@ -89,9 +115,20 @@ davidson(BigMatrixT const& A,
          ITensor& phi,
          Args const& args)
     {
+    auto info = DavidsonInfo{};
+    return davidson(A,phi,info,args);
+    }
+
+template <class BigMatrixT>
+Real
+davidson(BigMatrixT const& A, 
+         ITensor& phi,
+         DavidsonInfo& info,
+         Args const& args)
+    {
     auto v = std::vector<ITensor>(1);
     v.front() = phi;
-    auto eigs = davidson(A,v,args);
+    auto eigs = davidson(A,v,info,args);
     phi = v.front();
     return eigs.front();
     }
@@ -102,10 +139,28 @@ davidson(BigMatrixT const& A,
          std::vector<ITensor>& phi,
          Args const& args)
     {
-    auto maxiter_ = args.getSizeT("MaxIter",2);
-    auto errgoal_ = args.getReal("ErrGoal",1E-14);
-    auto debug_level_ = args.getInt("DebugLevel",-1);
-    auto miniter_ = args.getSizeT("MinIter",1);
+    auto info = DavidsonInfo{};
+    return davidson(A,phi,info,args);
+    }
+
+template <class BigMatrixT>
+std::vector<Real>
+davidson(BigMatrixT const& A, 
+         std::vector<ITensor>& phi,
+         DavidsonInfo& info,
+         Args const& args)
+    {
+    static const auto MaxIter = ArgName("MaxIter");
+    static const auto ErrGoal = ArgName("ErrGoal");
+    static const auto DebugLevel = ArgName("DebugLevel");
+    static const auto MinIter = ArgName("MinIter");
+
+    PROFILE_REGION("davidson");
+    auto mem_scope = MemoryScope("krylov");
+    auto maxiter_ = args.getSizeT(MaxIter,2);
+    auto errgoal_ = args.getReal(ErrGoal,1E-14);
+    auto debug_level_ = args.getInt(DebugLevel,-1);
+    auto miniter_ = args.getSizeT(MinIter,1);
 
     Real Approx0 = 1E-12;
 
@@ -162,11 +217,12 @@ davidson(BigMatrixT const& A,
     auto eigs = std::vector<Real>(nget,NAN);
 
     V[0] = phi.front();
-TIMER_START(31);
-    A.product(V[0],AV[0]);
-TIMER_STOP(31);
+        {
+        PROFILE_REGION("davidson.product");
+        A.product(V[0],AV[0]);
+        }
 
-    auto initEn = real(eltC((dag(V[0])*AV[0])));
+    auto initEn = real(dotC(V[0],AV[0]));
 
     if(debug_level_ > 2)
         printfln("Initial Davidson energy = %.10f",initEn);
@@ -312,7 +368,7 @@ TIMER_STOP(31);
             ++tot_pass;
             for(auto k : range(ni))
                 {
-                Vq[k] = eltC(dag(V[k])*q);
+                Vq[k] = dotC(V[k],q);
                 //printfln("pass=%d Vq[%d] = %s",pass,k,Vq[k]);
                 }
             for(auto k : range(ni))
@@ -380,9 +436,10 @@ TIMER_STOP(31);
         //Step G of Davidson (1975)
         //Expand AV and M
         //for next step
-TIMER_START(31);
-        A.product(V[ni],AV[ni]);
-TIMER_STOP(31);
+            {
+            PROFILE_REGION("davidson.product");
+            A.product(V[ni],AV[ni]);
+            }
 
         //Step H of Davidson (1975)
         //Add new row and column to M
@@ -390,7 +447,7 @@ TIMER_STOP(31);
         auto newCol = subVector(NC,0,1+ni);
         for(auto k : range(ni+1))
             {
-            newCol(k) = eltC(dag(V.at(k))*AV.at(ni));
+            newCol(k) = dotC(V.at(k),AV.at(ni));
             }
         column(Mref,ni) &= newCol;
         row(Mref,ni) &= conj(newCol);
@@ -429,7 +486,7 @@ TIMER_STOP(31);
         for(auto r : range(iter+1))
         for(auto c : range(r,iter+1))
             {
-            auto z = eltC(dag(V[r])*V[c]);
+            auto z = dotC(V[r],V[c]);
             Vo_final(r,c) = std::abs(z);
             Vo_final(c,r) = Vo_final(r,c);
             }
@@ -447,6 +504,8 @@ TIMER_STOP(31);
         println();
         }
 
+    info.iterations = iter;
+    info.residual = qnorm;
     return eigs;
     }
 
@@ -513,14 +572,14 @@ template<typename BigVectorT>
 void
 dot(BigVectorT const& A, BigVectorT const& B, Real& res)
     {
-    res = elt(dag(A)*B);
+    res = dot(A,B);
     }
 
 template<typename BigVectorT>
 void
 dot(BigVectorT const& A, BigVectorT const& B, Cplx& res)
     {
-    res = eltC(dag(A)*B);
+    res = dotC(A,B);
     }
 
 }//namespace gmres_details
@@ -644,6 +703,8 @@ gmres(BigMatrixT const& A,
       BigVectorT& x,
       Args const& args)
     {
+    PROFILE_REGION("gmres");
+    auto mem_scope = MemoryScope("krylov");
     auto debug_level_ = args.getInt("DebugLevel",-1);
 
     // Precompute Ax to figure out whether A or x is
@@ -970,6 +1031,7 @@ void
 applyExp(BigMatrixT const& H, ITensor& phi,
          ElT tau, Args const& args)
     {
+    PROFILE_REGION("applyExp");
     auto tol = args.getReal("ErrGoal",1E-10);
     auto max_iter = args.getInt("MaxIter",30);
     auto debug_level = args.getInt("DebugLevel",-1);
@@ -997,7 +1059,7 @@ applyExp(BigMatrixT const& H, ITensor& phi,
         H.product(v1, w);
 
         double avnorm = norm(w);
-        double alpha = real(eltC(dag(w) * v1));
+        double alpha = real(dotC(w,v1));
         bigTmat(iter, iter) = alpha;
         w -= alpha * v1;
         if (iter > 0)
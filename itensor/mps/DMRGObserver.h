@@ -18,6 +18,7 @@
 #include "itensor/mps/mps.h"
 #include "itensor/mps/observer.h"
 #include "itensor/spectrum.h"
+#include "itensor/util/perfcounters.h"
 
 namespace itensor {
 
@@ -52,6 +53,12 @@ class DMRGObserver : public Observer
     Spectrum const&
     spectrum() const { return last_spec_; }
 
+    //Performance counters (see util/perfcounters.h) 
+    //accumulated during the last completed sweep;
+    //all zero unless setPerfCounting(true) was called
+    PerfCounters const&
+    sweepPerf() const { return sweep_perf_; }
+
     private:
 
     /////////////
@@ -64,6 +71,8 @@ class DMRGObserver : public Observer
     bool done_;
     Real last_energy_;
     Spectrum last_spec_;
+    PerfCounters perf_start_;
+    PerfCounters sweep_perf_;
 
     /////////////
 
@@ -78,7 +87,8 @@ DMRGObserver(MPS const& psi, Args const& args)
     max_eigs(-1),
     max_te(-1),
     done_(false),
-    last_energy_(1000)
+    last_energy_(1000),
+    perf_start_(perfCounters())
     //default_ops_(psi.sites().defaultOps())
     { 
     }
@@ -143,6 +153,13 @@ measure(Args const& args)
             }
         }
 
+    if(b == 1 && ha == 2)
+        {
+        auto perf = perfCounters();
+        sweep_perf_ = perf-perf_start_;
+        perf_start_ = perf;
+        }
+
     max_eigs = std::max(max_eigs,last_spec_.numEigsKept());
     max_te = std::max(max_te,last_spec_.truncerr());
     if(!silent)
@@ -157,6 +174,7 @@ measure(Args const& args)
             println("    Largest truncation error: ",(max_te > 0 ? max_te : 0.));
             max_te = -1;
             printfln("    Energy after sweep %s is %.12f",swstr,energy);
+            if(perfCounting()) println(sweep_perf_);
             }
         }
 
@@ -16,12 +16,17 @@
 #ifndef __ITENSOR_DMRG_H
 #define __ITENSOR_DMRG_H
 
+#include <optional>
 #include "itensor/iterativesolvers.h"
 #include "itensor/mps/localmposet.h"
 #include "itensor/mps/localmpo_mps.h"
 #include "itensor/mps/sweeps.h"
 #include "itensor/mps/DMRGObserver.h"
 #include "itensor/util/cputime.h"
+#include "itensor/util/set_scoped.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/memory_usage.h"
+#include "itensor/util/telemetry.h"
 
 
 namespace itensor {
@@ -327,6 +332,12 @@ DMRGWorker(MPS & psi,
            DMRGObserver & obs,
            Args args)
     {
+    //Added to args at every bond
+    static const auto AtBond = ArgName("AtBond");
+    static const auto HalfSweep = ArgName("HalfSweep");
+    static const auto Energy = ArgName("Energy");
+    static const auto Truncerr = ArgName("Truncerr");
+
     if( args.defined("WriteM") )
       {
       if( args.defined("WriteDim") )
@@ -365,6 +376,9 @@ DMRGWorker(MPS & psi,
     for(int sw = 1; sw <= sweeps.nsweep(); ++sw)
         {
         cpu_time sw_time;
+        auto sw_profile = profiling() ? profileSummary() : ProfileSummary{};
+        auto sw_region = ProfileRegion("dmrg.sweep");
+        if(memoryTracking()) resetMemoryPeaks();
         args.add("Sweep",sw);
         args.add("NSweep",sweeps.nsweep());
         args.add("Cutoff",sweeps.cutoff(sw));
@@ -373,6 +387,10 @@ DMRGWorker(MPS & psi,
         args.add("Noise",sweeps.noise(sw));
         args.add("MaxIter",sweeps.niter(sw));
 
+        //Real matrix products in single precision during this sweep
+        //if requested by the precision() schedule of sweeps
+        SET_SCOPED(gemmSinglePrecision()) = (sweeps.precision(sw) == 32);
+
         if(!PH.doWrite()
            && args.defined("WriteDim")
            && sweeps.maxdim(sw) >= args.getInt("WriteDim"))
@@ -387,6 +405,7 @@ DMRGWorker(MPS & psi,
             PH.doWrite(true,args);
             }
 
+        auto sw_truncerr = 0.;
         for(int b = 1, ha = 1; ha <= 2; sweepnext(b,ha,N))
             {
             if(!quiet)
@@ -394,21 +413,41 @@ DMRGWorker(MPS & psi,
                 printfln("Sweep=%d, HS=%d, Bond=%d/%d",sw,ha,b,(N-1));
                 }
 
-TIMER_START(1);
-            PH.position(b,psi);
-TIMER_STOP(1);
+            PROFILE_REGION("dmrg.bond");
 
-TIMER_START(2);
-            auto phi = psi(b)*psi(b+1);
-TIMER_STOP(2);
+            //Phase times are only measured for telemetry
+            auto tele = telemetryOn();
+            auto phase_time = std::optional<cpu_time>{};
+            std::optional<cpu_time> position_time,
+                                    davidson_time,
+                                    svd_time;
+            if(tele) phase_time.emplace();
 
-TIMER_START(3);
-            energy = davidson(PH,phi,args);
-TIMER_STOP(3);
-            
-TIMER_START(4);
-            auto spec = psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,args);
-TIMER_STOP(4);
+                {
+                PROFILE_REGION("dmrg.position");
+                PH.position(b,psi);
+                }
+            if(tele) { position_time = phase_time->sincemark(); phase_time->mark(); }
+
+            auto phi = ITensor{};
+                {
+                PROFILE_REGION("dmrg.makePhi");
+                phi = psi(b)*psi(b+1);
+                }
+
+            auto dav_info = DavidsonInfo{};
+                {
+                PROFILE_REGION("dmrg.eigensolver");
+                energy = davidson(PH,phi,dav_info,args);
+                }
+            if(tele) { davidson_time = phase_time->sincemark(); phase_time->mark(); }
+
+            auto spec = Spectrum{};
+                {
+                PROFILE_REGION("dmrg.svdBond");
+                spec = psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,args);
+                }
+            if(tele) svd_time = phase_time->sincemark();
 
             if(!quiet)
                 { 
@@ -422,25 +461,75 @@ TIMER_STOP(4);
                 }
 
             obs.lastSpectrum(spec);
+            sw_truncerr = std::max(sw_truncerr,spec.truncerr());
 
-            args.add("AtBond",b);
-            args.add("HalfSweep",ha);
-            args.add("Energy",energy); 
-            args.add("Truncerr",spec.truncerr()); 
+            args.add(AtBond,b);
+            args.add(HalfSweep,ha);
+            args.add(Energy,energy); 
+            args.add(Truncerr,spec.truncerr()); 
 
             obs.measure(args);
 
+            if(tele)
+                {
+                auto mem = memoryUsage();
+                auto r = TelemetryRecord("dmrg_bond");
+                r.add("sweep",sw)
+                 .add("half_sweep",ha)
+                 .add("bond",b)
+                 .add("energy",energy)
+                 .add("truncerr",spec.truncerr())
+                 .add("bond_dim",long(dim(linkIndex(psi,b))))
+                 .add("davidson_iter",dav_info.iterations)
+                 .add("davidson_residual",dav_info.residual)
+                 .add("position_wall",position_time->wall)
+                 .add("position_cpu",position_time->time)
+                 .add("davidson_wall",davidson_time->wall)
+                 .add("davidson_cpu",davidson_time->time)
+                 .add("svd_wall",svd_time->wall)
+                 .add("svd_cpu",svd_time->time)
+                 .add("mem_live",mem.live)
+                 .add("mem_peak",mem.peak);
+                emitTelemetry(std::move(r));
+                }
+
+            //Soft memory limit (see setMemoryLimit):
+            //move environment tensors to disk once exceeded
+            if(!PH.doWrite() && memoryLimitExceeded())
+                {
+                if(!quiet)
+                    {
+                    printfln("\nMemory limit of %.2f MB exceeded, turning on write to disk, write_dir = %s",
+                             1E-6*memoryLimit(),args.getString("WriteDir","./"));
+                    }
+                PH.doWrite(true,args);
+                }
+
             } //for loop over b
 
+        sw_region.end();
+
+        if(telemetryOn())
+            {
+            auto sm = sw_time.sincemark();
+            auto r = TelemetryRecord("dmrg_sweep");
+            r.add("sweep",sw)
+             .add("energy",energy)
+             .add("max_bond_dim",long(maxLinkDim(psi)))
+             .add("max_truncerr",sw_truncerr)
+             .add("wall",sm.wall)
+             .add("cpu",sm.time)
+             .add("mem_peak",memoryUsage().peak);
+            emitTelemetry(std::move(r));
+            }
+
         if(!silent)
             {
             auto sm = sw_time.sincemark();
             printfln("    Sweep %d/%d CPU time = %s (Wall time = %s)",
                       sw,sweeps.nsweep(),showtime(sm.time),showtime(sm.wall));
-#ifdef COLLECT_TIMES
-            println(timers());
-            timers().reset();
-#endif
+            if(profiling()) println(profileSummary(sw_profile));
+            if(memoryTracking()) println(memoryReport());
             }
 
         if(obs.checkDone(args)) break;
@@ -0,0 +1,273 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_IDMRG_H
+#define __ITENSOR_IDMRG_H
+
+#include "itensor/mps/dmrg.h"
+
+namespace itensor {
+
+//
+// Infinite DMRG (I. McCulloch, arXiv:0804.2509)
+//
+// psi holds two unit cells, sites 1..Nuc and Nuc+1..2*Nuc
+// (Nuc = length(psi)/2). H is the MPO of the same 2*Nuc
+// sites, with the link index after site 2*Nuc being the
+// link before site 1, and with boundary vectors H(0) and
+// H(2*Nuc+1) which select the starting and ending states
+// of the MPO (see sample/Heisenberg.h with "Infinite").
+//
+// Each step optimizes psi by finite DMRG sweeps, using
+// boundary tensors HL and HR for the sites added so far.
+// Then the left unit cell is added to HL, the right unit
+// cell to HR, and the unit cells of psi and H are swapped,
+// so the system grows by 2*Nuc sites per step. The starting
+// psi of the next step is predicted from the last two
+// center matrices, L*B..B*inverse(L_old)*A..A*L, which is
+// close to the next ground state and needs few Davidson
+// iterations.
+//
+// Step sw uses the cutoff, dimensions, noise and Davidson
+// iterations of sweep sw of "sweeps".
+//
+// On return psi holds the last unit cells, left-orthogonal
+// up to site Nuc and with the orthogonality center at site
+// Nuc+1; sites 1 and 2*Nuc have link indices to HL and HR.
+//
+// Args:
+// "NUCSweeps" (default 1) - finite sweeps of psi per step
+// "EnergyErrgoal" (default 0) - stop when the energy per
+//                 site changes by less than this
+// "KeepFinite" (default false) - keep the tensors of every
+//              step, so finiteMPS can make an MPS of the
+//              whole system (for example to start dmrg)
+// "Quiet" (default false) - do not print each step
+// "OutputLevel" (default 0) - if 1 or more, print the
+//               finite sweeps too
+//
+struct IDMRGResult
+    {
+    //Energy per site
+    Real energy = NAN;
+    //Energy of the whole system
+    Real total_energy = NAN;
+    //Number of sites of the whole system
+    int length = 0;
+    //Boundary tensors of psi
+    ITensor HL,
+            HR;
+    //Singular values between the unit cells of psi
+    ITensor center;
+    //If KeepFinite: the left-orthogonal tensors of the
+    //left half and the right-orthogonal tensors of the
+    //right half of the whole system
+    std::vector<ITensor> left,
+                         right;
+    };
+
+IDMRGResult
+idmrg(MPS & psi,
+      MPO H,
+      Sweeps const& sweeps,
+      Args const& args = Args::global());
+
+//
+// MPS of the whole system grown by idmrg
+// (called with "KeepFinite"), on the sites of a
+// finite SiteSet with the same number of sites.
+// The orthogonality center is at the first site
+// of the right half.
+//
+MPS
+finiteMPS(IDMRGResult const& res,
+          SiteSet const& sites);
+
+
+//
+// Implementation
+//
+
+namespace detail {
+
+void inline
+swapUnitCells(std::vector<ITensor*> const& T)
+    {
+    auto Nuc = T.size()/2;
+    for(auto n : range(Nuc)) T[n]->swap(*T[Nuc+n]);
+    }
+
+} //namespace detail
+
+IDMRGResult inline
+idmrg(MPS & psi,
+      MPO H,
+      Sweeps const& sweeps,
+      Args const& args)
+    {
+    auto N0 = length(psi);
+    if(N0%2 != 0) Error("idmrg: psi must have an even number of sites (two unit cells)");
+    if(length(H) != N0) Error("idmrg: H and psi must have the same number of sites");
+    if(!H(0) || !H(N0+1)) Error("idmrg: H must have boundary vectors H(0) and H(N+1)");
+    auto Nuc = N0/2;
+
+    auto olevel = args.getInt("OutputLevel",0);
+    auto quiet = args.getBool("Quiet",args.getBool("Silent",false));
+    auto nucsweeps = args.getInt("NUCSweeps",1);
+    auto errgoal = args.getReal("EnergyErrgoal",0.);
+    auto keep_finite = args.getBool("KeepFinite",false);
+
+    auto res = IDMRGResult{};
+    res.HL = H(0);
+    res.HR = H(N0+1);
+    auto& HL = res.HL;
+    auto& HR = res.HR;
+
+    //Center matrix of the last step, and of the step before
+    auto D = ITensor{},
+         lastD = ITensor{};
+    auto V = ITensor{};
+    auto scratch = NetworkScratch{};
+
+    for(int sw = 1; sw <= sweeps.nsweep(); ++sw)
+        {
+        if(sw > 1)
+            {
+            //Add the left unit cell to HL and the right one to HR
+            for(int n = 1; n <= Nuc; ++n)
+                {
+                auto Ad = dag(prime(psi(n)));
+                contractNetwork({&HL,&psi(n),&H(n),&Ad},HL,scratch);
+                }
+            psi.ref(Nuc+1) = V;
+            for(int n = N0; n > Nuc; --n)
+                {
+                auto Bd = dag(prime(psi(n)));
+                contractNetwork({&HR,&psi(n),&H(n),&Bd},HR,scratch);
+                }
+
+            auto P = std::vector<ITensor*>(N0),
+                 W = std::vector<ITensor*>(N0);
+            for(auto n : range1(N0))
+                {
+                P[n-1] = &psi.ref(n);
+                W[n-1] = &H.ref(n);
+                }
+            detail::swapUnitCells(P);
+            detail::swapUnitCells(W);
+
+            //Predict the new psi: the outer links of the old right
+            //and left unit cells join HL and HR through D, and
+            //their inner links are joined by the inverse of lastD
+            psi.ref(1) *= D;
+            psi.ref(N0) *= D;
+            if(lastD)
+                {
+                auto Vinv = dag(lastD);
+                Vinv.apply([](Real x) { return x > 1E-12 ? 1./x : 0.; });
+                psi.ref(Nuc+1) *= Vinv;
+                }
+            else
+                {
+                //First step: the finite system had no outer links
+                auto l = hasQNs(psi(1)) ? Index(QN(),1,"Link") : Index(1,"Link");
+                psi.ref(Nuc) *= setElt(l(1));
+                psi.ref(Nuc+1) *= setElt(dag(l)(1));
+                }
+            psi.leftLim(0);
+            psi.rightLim(N0+1);
+            }
+
+        auto ucsweeps = Sweeps(nucsweeps);
+        for(auto n : range1(nucsweeps))
+            {
+            ucsweeps.setmindim(n,sweeps.mindim(sw));
+            ucsweeps.setmaxdim(n,sweeps.maxdim(sw));
+            ucsweeps.setcutoff(n,sweeps.cutoff(sw));
+            ucsweeps.setnoise(n,sweeps.noise(sw));
+            ucsweeps.setniter(n,sweeps.niter(sw));
+            ucsweeps.setprecision(n,sweeps.precision(sw));
+            }
+
+        auto PH = LocalMPO(H,HL,0,HR,N0+1,args);
+        auto E = DMRGWorker(psi,PH,ucsweeps,{args,"Silent=",olevel < 1,"Quiet=",olevel < 1});
+
+        auto last_energy = res.energy;
+        res.energy = (sw == 1) ? E/N0 : (E-res.total_energy)/N0;
+        res.total_energy = E;
+        res.length = N0*sw;
+
+        //Center matrix between the unit cells
+        psi.position(Nuc);
+        lastD = D;
+        auto U = ITensor{};
+        std::tie(U,D,V) = svd(psi(Nuc)*psi(Nuc+1),uniqueInds(psi(Nuc),psi(Nuc+1)),
+                              {"Cutoff=",sweeps.cutoff(sw),
+                               "MaxDim=",sweeps.maxdim(sw),
+                               "MinDim=",sweeps.mindim(sw),
+                               "RespectDegenerate=",true});
+        D /= norm(D);
+        psi.ref(Nuc) = U;
+
+        if(keep_finite)
+            {
+            for(int n = 1; n <= Nuc; ++n) res.left.push_back(psi(n));
+            auto R = std::vector<ITensor>{V};
+            for(int n = Nuc+2; n <= N0; ++n) R.push_back(psi(n));
+            res.right.insert(res.right.begin(),R.begin(),R.end());
+            }
+
+        if(!quiet)
+            {
+            printfln("iDMRG step %d, N = %d, energy per site = %.14f, dim = %d",
+                     sw,res.length,res.energy,dim(commonIndex(U,D)));
+            }
+
+        if(sw > 1 && std::fabs(res.energy-last_energy) < errgoal) break;
+        }
+
+    psi.ref(Nuc+1) = D*V;
+    psi.leftLim(Nuc);
+    psi.rightLim(Nuc+2);
+    res.center = D;
+    return res;
+    }
+
+MPS inline
+finiteMPS(IDMRGResult const& res,
+          SiteSet const& sites)
+    {
+    auto nl = int(res.left.size());
+    auto N = nl+int(res.right.size());
+    if(N == 0) Error("finiteMPS: no tensors kept, call idmrg with \"KeepFinite\"");
+    if(length(sites) != N) Error(format("finiteMPS: SiteSet has %d sites, system has %d",length(sites),N));
+
+    auto psi = MPS(sites);
+    for(auto j : range1(N))
+        {
+        auto T = (j <= nl) ? res.left.at(j-1) : res.right.at(j-nl-1);
+        if(j == nl+1) T *= res.center;
+        auto s = findIndex(T,"Site,0");
+        T.replaceInds({s},{sites(j)});
+        psi.ref(j) = T;
+        }
+    psi.leftLim(nl);
+    psi.rightLim(nl+2);
+    return psi;
+    }
+
+} //namespace itensor
+
+#endif
@@ -17,7 +17,9 @@
 #define __ITENSOR_LOCALMPO
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/localop.h"
+#include "itensor/contractnetwork.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/util/memory_usage.h"
 
 namespace itensor {
 
@@ -205,6 +207,14 @@ class LocalMPO
         if(!do_write_ && (val == true))
             {
             initWrite(args); 
+            //Move environments other than the current ones
+            //to disk, so turning on writing mid-sweep frees memory
+            for(auto n : range(PH_.size()))
+                {
+                if(int(n) == LHlim_ || int(n) == RHlim_ || !PH_[n]) continue;
+                writeToFile(PHFName(n),PH_[n]);
+                PH_[n] = ITensor();
+                }
             }
         do_write_ = val; 
         }
@@ -485,6 +495,7 @@ shift(int j,
       ITensor const& A)
     {
     if(!(*this)) Error("LocalMPO is null");
+    lop_.clearWork();
 
 #ifdef DEBUG
     if(nc_ != 2 && nc_ != 1 && nc_ != 0)
@@ -502,9 +513,9 @@ shift(int j,
             }
         auto& E = PH_.at(LHlim_);
         auto& nE = PH_.at(j);
-        nE = E * A;
-        nE *= Op_->A(j);
-        nE *= dag(prime(A));
+        auto Ad = dag(prime(A));
+        auto scratch = NetworkScratch{};
+        contractNetwork({&E,&A,&Op_->A(j),&Ad},nE,scratch);
         setLHlim(j);
         setRHlim(j+nc_+1);
 
@@ -524,9 +535,9 @@ shift(int j,
             }
         auto& E = PH_.at(RHlim_);
         auto& nE = PH_.at(j);
-        nE = E * A;
-        nE *= Op_->A(j);
-        nE *= dag(prime(A));
+        auto Ad = dag(prime(A));
+        auto scratch = NetworkScratch{};
+        contractNetwork({&E,&A,&Op_->A(j),&Ad},nE,scratch);
         setLHlim(j-nc_-1);
         setRHlim(j);
 	
@@ -542,6 +553,11 @@ shift(int j,
 inline void LocalMPO::
 makeL(MPS const& psi, int k)
     {
+    auto mem_scope = MemoryScope("environment");
+    lop_.clearWork();
+    //Intermediates are freed on return: environment
+    //indices change from one update to the next
+    auto scratch = NetworkScratch{};
     if(!PH_.empty())
         {
         if(Op_ == 0) //Op is actually an MPS
@@ -549,8 +565,8 @@ makeL(MPS const& psi, int k)
             while(LHlim_ < k)
                 {
                 auto ll = LHlim_;
-                PH_.at(ll+1) = (!PH_.at(ll) ? psi(ll+1) : PH_[ll]*psi(ll+1));
-                PH_[ll+1] *= dag(prime(Psi_->A(ll+1),"Link"));
+                auto Pd = dag(prime(Psi_->A(ll+1),"Link"));
+                contractNetwork({&PH_.at(ll),&psi(ll+1),&Pd},PH_.at(ll+1),scratch);
                 setLHlim(ll+1);
                 }
             }
@@ -559,16 +575,10 @@ makeL(MPS const& psi, int k)
             while(LHlim_ < k)
                 {
                 auto ll = LHlim_;
-                if(PH_.at(ll))
-                    {
-                    PH_.at(ll+1) = PH_.at(ll)*psi(ll+1);
-                    }
-                else
-                    {
-                    PH_.at(ll+1) = psi(ll+1);
-                    }
-                PH_.at(ll+1) *= Op_->A(ll+1);
-                PH_.at(ll+1) *= dag(prime(psi(ll+1)));
+                //PH_.at(ll) is default constructed at the edge,
+                //and is then skipped by contractNetwork
+                auto Ad = dag(prime(psi(ll+1)));
+                contractNetwork({&PH_.at(ll),&psi(ll+1),&Op_->A(ll+1),&Ad},PH_.at(ll+1),scratch);
                 setLHlim(ll+1);
                 }
             }
@@ -578,6 +588,11 @@ makeL(MPS const& psi, int k)
 inline void LocalMPO::
 makeR(MPS const& psi, int k)
     {
+    auto mem_scope = MemoryScope("environment");
+    lop_.clearWork();
+    //Intermediates are freed on return: environment
+    //indices change from one update to the next
+    auto scratch = NetworkScratch{};
     if(!PH_.empty())
         {
         if(Op_ == 0) //Op is actually an MPS
@@ -585,8 +600,8 @@ makeR(MPS const& psi, int k)
             while(RHlim_ > k)
                 {
                 const int rl = RHlim_;
-                PH_.at(rl-1) = (!PH_.at(rl) ? psi(rl-1) : PH_[rl]*psi(rl-1));
-                PH_[rl-1] *= dag(prime(Psi_->A(rl-1),"Link"));
+                auto Pd = dag(prime(Psi_->A(rl-1),"Link"));
+                contractNetwork({&PH_.at(rl),&psi(rl-1),&Pd},PH_.at(rl-1),scratch);
                 setRHlim(rl-1);
                 }
             }
@@ -599,16 +614,8 @@ makeR(MPS const& psi, int k)
                 //Print(PH_.at(rl));
                 //Print(Op_->A(rl-1));
                 //Print(psi(rl-1));
-                if(PH_.at(rl))
-                    {
-                    PH_.at(rl-1) = PH_.at(rl)*psi(rl-1);
-                    }
-                else
-                    {
-                    PH_.at(rl-1) = psi(rl-1);
-                    }
-                PH_.at(rl-1) *= Op_->A(rl-1);
-                PH_.at(rl-1) *= dag(prime(psi(rl-1)));
+                auto Ad = dag(prime(psi(rl-1)));
+                contractNetwork({&PH_.at(rl),&psi(rl-1),&Op_->A(rl-1),&Ad},PH_.at(rl-1),scratch);
                 //printfln("PH[%d] = \n%s",rl-1,PH_.at(rl-1));
                 //PAUSE
                 setRHlim(rl-1);
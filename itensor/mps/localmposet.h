@@ -16,13 +16,30 @@
 #ifndef __ITENSOR_LOCALMPOSET
 #define __ITENSOR_LOCALMPOSET
 #include "itensor/mps/localmpo.h"
+#include "itensor/util/parallel_for.h"
 
 namespace itensor {
 
+//
+// Sum of several MPOs, each with its own environments.
+// The members are independent until their results are
+// summed, so product, expect, shift and position work on
+// the members concurrently.
+//
+// Args:
+// "NThread" (default 1) - threads used for the members.
+//           Each thread calls BLAS, so with a threaded
+//           BLAS library limit its threads (for example
+//           OMP_NUM_THREADS) to keep NThread times that
+//           number within the number of cores.
+//
 class LocalMPOSet
     {
     std::vector<MPO> const* Op_ = nullptr;
     std::vector<LocalMPO> lmpo_;
+    int nthread_ = 1;
+    //Products of the members after the first
+    mutable std::vector<ITensor> partial_;
     public:
 
     LocalMPOSet(Args const& args = Args::global()) { }
@@ -85,7 +102,7 @@ class LocalMPOSet
     void
     shift(int j, Direction dir, ITensor const& A)
         {
-        for(auto n : range(lmpo_)) lmpo_[n].shift(j,dir,A);
+        parallelFor(lmpo_.size(),nthreadFor(A),[&](size_t n) { lmpo_[n].shift(j,dir,A); });
         }
 
     int
@@ -99,6 +116,11 @@ class LocalMPOSet
     explicit
     operator bool() const { return bool(Op_); }
 
+    int
+    nthread() const { return nthread_; }
+    void
+    nthread(int val) { nthread_ = std::max(1,val); }
+
     bool
     doWrite() const { return lmpo_.front().doWrite(); }
     void
@@ -107,6 +129,18 @@ class LocalMPOSet
         for(auto& lm : lmpo_) lm.doWrite(val,args);
         }
 
+    private:
+
+    //Threads to use for work on tensors the size of T;
+    //for small tensors starting threads costs more
+    //than it saves
+    int
+    nthreadFor(ITensor const& T) const
+        {
+        const long min_dim = 1l << 12;
+        return dim(inds(T)) < min_dim ? 1 : nthread_;
+        }
+
     };
 
 inline LocalMPOSet::
@@ -115,6 +149,7 @@ LocalMPOSet(std::vector<MPO> const& Op,
   : Op_(&Op),
     lmpo_(Op.size())
     { 
+    nthread(args.getInt("NThread",1));
     for(auto n : range(lmpo_.size()))
         {
         lmpo_[n] = LocalMPO(Op.at(n),args);
@@ -131,6 +166,7 @@ LocalMPOSet(std::vector<MPO> const& H,
   : Op_(&H),
     lmpo_(H.size())
     { 
+    nthread(args.getInt("NThread",1));
     for(auto n : range(lmpo_.size()))
         {
         lmpo_[n] = LocalMPO(H.at(n),LH.at(n),LHlim,RH.at(n),RHlim,args);
@@ -141,25 +177,24 @@ void inline LocalMPOSet::
 product(ITensor const& phi, 
         ITensor & phip) const
     {
-    lmpo_.front().product(phi,phip);
-
-    ITensor phi_n;
-    for(auto n : range(1,lmpo_.size()))
-        {
-        lmpo_[n].product(phi,phi_n);
-        phip += phi_n;
-        }
+    auto N = lmpo_.size();
+    partial_.resize(N-1);
+    auto P = std::vector<ITensor*>(N);
+    P[0] = &phip;
+    for(auto n : range(1,N)) P[n] = &partial_[n-1];
+
+    auto nt = nthreadFor(phi);
+    parallelFor(N,nt,[&](size_t n) { lmpo_[n].product(phi,*P[n]); });
+    parallelSum(P,nt);
     }
 
 Real inline LocalMPOSet::
 expect(ITensor const& phi) const
     {
+    auto ex = std::vector<Real>(lmpo_.size());
+    parallelFor(lmpo_.size(),nthreadFor(phi),[&](size_t n) { ex[n] = lmpo_[n].expect(phi); });
     Real ex_ = 0;
-    for(size_t n = 0; n < lmpo_.size(); ++n)
-    for(auto n : range(lmpo_.size()))
-        {
-        ex_ += lmpo_[n].expect(phi);
-        }
+    for(auto x : ex) ex_ += x;
     return ex_;
     }
 
@@ -191,10 +226,7 @@ void inline LocalMPOSet::
 position(int b, 
          MPS const& psi)
     {
-    for(auto n : range(lmpo_.size()))
-        {
-        lmpo_[n].position(b,psi);
-        }
+    parallelFor(lmpo_.size(),nthread_,[&](size_t n) { lmpo_[n].position(b,psi); });
     }
 
 void inline LocalMPOSet::
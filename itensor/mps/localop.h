@@ -15,6 +15,7 @@
 //
 #ifndef __ITENSOR_LOCAL_OP
 #define __ITENSOR_LOCAL_OP
+#include <array>
 #include "itensor/itensor.h"
 //#include "itensor/util/print_macro.h"
 
@@ -49,6 +50,10 @@ class LocalOp
     ITensor const* R_;
     mutable size_t size_;
     int nc_;
+    //Intermediate products of product(), kept so that
+    //repeated calls (as in Davidson) reuse their storage;
+    //freed when the operators change (see clearWork)
+    mutable std::array<ITensor,3> work_;
     public:
 
 
@@ -131,6 +136,10 @@ class LocalOp
            ITensor const& L, 
            ITensor const& R);
 
+    //Free the intermediates kept by product()
+    void
+    clearWork() const { work_.fill(ITensor()); }
+
     ITensor const&
     Op1() const 
         { 
@@ -268,6 +277,7 @@ updateOp(const ITensor& Op1)
     R_ = nullptr;
     size_ = -1;
     nc_ = 1;
+    clearWork();
     }
 
 void inline LocalOp::
@@ -279,6 +289,7 @@ updateOp(const ITensor& Op1, const ITensor& Op2)
     R_ = nullptr;
     size_ = -1;
     nc_ = 2;
+    clearWork();
     }
 
 void inline LocalOp::
@@ -290,6 +301,7 @@ update(const ITensor& L, const ITensor& R)
     R_ = &R;
     size_ = -1;
     nc_ = 0;
+    clearWork();
     }
 
 void inline LocalOp::
@@ -330,38 +342,49 @@ product(ITensor const& phi,
     {
     if(!(*this)) Error("LocalOp is null");
 
+    //Factors to multiply phi by, in order
+    auto F = std::array<ITensor const*,4>{};
+    auto nf = 0;
     if(LIsNull())
         {
-        phip = phi;
         if(!RIsNull()) 
-            phip *= R(); //m^3 k d
+            F[nf++] = R_; //m^3 k d
         
         if(nc_ == 2)
             {
-            phip *= (*Op2_); //m^2 k^2
-            phip *= (*Op1_); //m^2 k^2
+            F[nf++] = Op2_; //m^2 k^2
+            F[nf++] = Op1_; //m^2 k^2
             }
         else if(nc_ == 1)
             {
-            phip *= (*Op1_);
+            F[nf++] = Op1_;
             }
         }
     else
         {
-        phip = phi * L(); //m^3 k d
+        F[nf++] = L_; //m^3 k d
 
         if(nc_ == 2)
             {
-            phip *= (*Op1_); //m^2 k^2
-            phip *= (*Op2_); //m^2 k^2
+            F[nf++] = Op1_; //m^2 k^2
+            F[nf++] = Op2_; //m^2 k^2
             }
         else if(nc_ == 1)
             {
-            phip *= (*Op1_);
+            F[nf++] = Op1_;
             }
 
         if(!RIsNull()) 
-            phip *= R();
+            F[nf++] = R_;
+        }
+
+    if(nf == 0) phip = phi;
+    auto* prev = &phi;
+    for(auto n : range(nf))
+        {
+        auto& next = (n+1 == nf) ? phip : work_[n];
+        contractInto(*prev,*F[n],next);
+        prev = &next;
         }
 
     phip.noPrime();
@@ -372,7 +395,7 @@ expect(const ITensor& phi) const
     {
     ITensor phip;
     product(phi,phip);
-    return real(eltC(dag(phip) * phi));
+    return real(dotC(phip,phi));
     }
 
 ITensor inline LocalOp::
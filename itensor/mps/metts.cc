@@ -0,0 +1,246 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "itensor/mps/metts.h"
+#include "itensor/mps/tevol.h"
+#include "itensor/util/parallel_for.h"
+
+namespace itensor {
+
+using std::vector;
+using std::string;
+
+namespace detail {
+
+//
+// States a site can collapse into, made once
+// and reused for every collapse
+//
+struct CollapseStates
+    {
+    //states[j-1][k-1]: state k of site j
+    vector<vector<ITensor>> states;
+    //Site indices, and links of the product state
+    vector<Index> sites,
+                  links;
+    bool xbasis = false;
+
+    CollapseStates() { }
+
+    CollapseStates(IndexSet const& is,
+                   string const& basis)
+        {
+        auto N = length(is);
+        auto qns = hasQNs(is);
+        if(basis == "X")
+            {
+            if(qns) Error("collapse: X basis not possible for sites with QNs");
+            xbasis = true;
+            }
+        else if(basis != "Z")
+            {
+            Error("collapse: Basis \"" + basis + "\" not recognized");
+            }
+        states.resize(N);
+        for(auto j : range1(N))
+            {
+            auto s = is(j);
+            sites.push_back(s);
+            auto& S = states[j-1];
+            if(xbasis)
+                {
+                if(dim(s) != 2) Error("collapse: X basis needs sites of dimension 2");
+                auto c = 1./std::sqrt(2.);
+                S.push_back(c*setElt(s(1))+c*setElt(s(2)));
+                S.push_back(c*setElt(s(1))-c*setElt(s(2)));
+                }
+            else
+                {
+                for(auto k : range1(dim(s))) S.push_back(setElt(s(k)));
+                }
+            }
+        for(auto j : range1(N-1))
+            {
+            auto ts = format("Link,l=%d",j);
+            links.push_back(qns ? Index(QN(),1,ts) : Index(1,ts));
+            }
+        }
+    };
+
+vector<int>
+collapse(MPS & psi,
+         RandomStream & rng,
+         CollapseStates const& C)
+    {
+    auto N = length(psi);
+    auto st = vector<int>(N+1,0);
+    psi.position(1);
+    auto A = psi(1);
+    auto probs = vector<Real>{};
+    for(auto j : range1(N))
+        {
+        auto& S = C.states[j-1];
+        auto s = C.sites[j-1];
+
+        //Reduced density matrix of site j; every
+        //other index of A has been projected out
+        auto rho = A*dag(prime(A,s));
+        probs.resize(S.size());
+        Real tot = 0.;
+        for(auto k : range(S.size()))
+            {
+            if(C.xbasis) probs[k] = real(eltC(dag(S[k])*rho*prime(S[k])));
+            else         probs[k] = std::max(0.,real(eltC(rho,s(k+1),prime(s)(k+1))));
+            tot += probs[k];
+            }
+
+        auto r = tot*rng.uniform();
+        size_t k = 0;
+        for(Real cum = probs[0]; k+1 < S.size() && cum <= r; cum += probs[++k]) { }
+        //States of zero probability are never chosen
+        while(probs[k] <= 0. && k > 0) --k;
+        st[j] = 1+int(k);
+
+        if(j < N)
+            {
+            A = psi(j+1)*(dag(S[k])*A);
+            A /= norm(A);
+            }
+        }
+
+    //Product state
+    for(auto j : range1(N))
+        {
+        auto T = C.states[j-1][st[j]-1];
+        if(j > 1) T *= setElt(dag(C.links[j-2])(1));
+        if(j < N) T *= setElt(C.links[j-1](1));
+        psi.ref(j) = T;
+        }
+    psi.leftLim(0);
+    psi.rightLim(2);
+    return st;
+    }
+
+} //namespace detail
+
+vector<int>
+collapse(MPS & psi,
+         RandomStream & rng,
+         Args const& args)
+    {
+    auto C = detail::CollapseStates(siteInds(psi),args.getString("Basis","Z"));
+    return detail::collapse(psi,rng,C);
+    }
+
+METTSEvolver
+mettsMPOEvolver(MPO const& expH,
+                int nstep,
+                Args const& args)
+    {
+    return [&expH,nstep,args](MPS & psi)
+        {
+        for(auto n : range(nstep))
+            {
+            (void)n;
+            psi = applyMPO(expH,psi,args);
+            psi.noPrime();
+            psi.normalize();
+            }
+        };
+    }
+
+METTSEvolver
+mettsGateEvolver(vector<BondGate> const& gates,
+                 Real ttotal,
+                 Real tstep,
+                 Args const& args)
+    {
+    return [&gates,ttotal,tstep,args](MPS & psi)
+        {
+        gateTEvol(gates,ttotal,tstep,psi,{args,"Verbose=",false,"Normalize=",true});
+        };
+    }
+
+Stats const& METTSResult::
+operator()(string const& name) const
+    {
+    for(auto o : range(names.size()))
+        {
+        if(names[o] == name) return stats.at(o);
+        }
+    Error("METTSResult: no observable named \"" + name + "\"");
+    return stats.front();
+    }
+
+METTSResult
+metts(MPS const& psi0,
+      METTSEvolver const& evolve,
+      vector<METTSObservable> const& obs,
+      Args const& args)
+    {
+    auto nchain = args.getInt("NChain",1);
+    auto nmetts = args.getInt("NMETTS",100);
+    auto nwarm = args.getInt("NWarm",5);
+    auto nthread = args.getInt("NThread",hardwareThreads());
+    auto basis = args.getString("Basis","Z");
+    auto offset = args.getInt("StreamOffset",0);
+    auto quiet = args.getBool("Quiet",true);
+
+    auto alternate = (basis == "Alternate");
+    auto sites = siteInds(psi0);
+    auto Z = detail::CollapseStates(sites,alternate ? "Z" : basis);
+    auto X = alternate ? detail::CollapseStates(sites,"X") : detail::CollapseStates{};
+
+    auto res = METTSResult{};
+    auto nobs = obs.size();
+    for(auto& o : obs) res.names.push_back(o.name);
+    res.chain_stats.assign(nchain,vector<Stats>(nobs));
+
+    parallelFor(nchain,nthread,[&](size_t c)
+        {
+        auto rng = taskRandomStream(offset+c);
+        auto& cs = res.chain_stats[c];
+        auto psi = psi0;
+        for(int step = 1; step <= nwarm+nmetts; ++step)
+            {
+            evolve(psi);
+            if(step > nwarm)
+                {
+                for(auto o : range(nobs)) cs[o].putin(obs[o].f(psi));
+                }
+            if(!quiet)
+                {
+                auto line = format("METTS chain %d, step %d, max bond dim = %d",c,step,maxLinkDim(psi));
+                for(auto o : range(nobs))
+                    {
+                    if(step > nwarm) line += format(", %s = %.10f",obs[o].name,cs[o].dat.back());
+                    }
+                println(line);
+                }
+            auto& C = (alternate && step%2 == 0) ? X : Z;
+            detail::collapse(psi,rng,C);
+            }
+        });
+
+    res.stats.resize(nobs);
+    for(auto& cs : res.chain_stats)
+    for(auto o : range(nobs))
+        {
+        for(auto x : cs[o].dat) res.stats[o].putin(x);
+        }
+    return res;
+    }
+
+} //namespace itensor
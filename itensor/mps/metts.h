@@ -0,0 +1,155 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_METTS_H
+#define __ITENSOR_METTS_H
+
+#include <functional>
+#include "itensor/mps/mpo.h"
+#include "itensor/mps/bondgate.h"
+#include "itensor/util/random.h"
+#include "itensor/util/stats.h"
+
+//
+// Minimally entangled typical thermal states
+// (S. White, PRL 102, 190601 and E.M. Stoudenmire
+// and S. White, NJP 12, 055026)
+//
+
+namespace itensor {
+
+//
+// Collapse psi into a product state |s_1 s_2 ... s_N>
+// drawn with probability |<s_1 s_2 ... s_N|psi>|^2.
+// Site j is sampled from its reduced density matrix
+// given the states chosen for sites 1..j-1, which gives
+// the probabilities of all states of the site at once.
+// Random numbers are taken from rng (uniform in [0,1));
+// a state of zero probability is never chosen.
+//
+// psi is replaced by the product state, with link
+// indices of dimension 1 (carrying no QN flux, so
+// each site tensor has the QN of its state).
+// Returns the number (1,2,...) of the state chosen
+// at each site; element 0 is not used.
+//
+// Args:
+// "Basis" (default "Z") - "Z" samples the states of
+//         the site indices; "X" samples the states
+//         (|1>+|2>)/sqrt(2) (number 1) and
+//         (|1>-|2>)/sqrt(2) (number 2) of sites of
+//         dimension 2 (not possible if psi has QNs)
+//
+std::vector<int>
+collapse(MPS & psi,
+         RandomStream & rng,
+         Args const& args = Args::global());
+
+//
+// Imaginary time evolution used by metts:
+// replaces psi by exp(-beta*H/2)|psi>, normalized
+//
+using METTSEvolver = std::function<void(MPS &)>;
+
+//
+// Evolver applying expH (for example made by
+// toExpH(ampo,tau)) nstep times with applyMPO,
+// so tau*nstep should be beta/2. args is passed
+// to applyMPO (for example "Cutoff", "MaxDim").
+// expH is kept by reference.
+//
+METTSEvolver
+mettsMPOEvolver(MPO const& expH,
+                int nstep,
+                Args const& args = Args::global());
+
+//
+// Evolver calling gateTEvol(gates,ttotal,tstep,psi,args)
+// with imaginary time gates (BondGate::tImag), so ttotal
+// should be beta/2. gates are kept by reference.
+//
+METTSEvolver
+mettsGateEvolver(std::vector<BondGate> const& gates,
+                 Real ttotal,
+                 Real tstep,
+                 Args const& args = Args::global());
+
+//
+// Quantity measured on each METTS. Observables of
+// different chains are called concurrently, so f
+// must not change shared data.
+//
+struct METTSObservable
+    {
+    std::string name;
+    std::function<Real(MPS const&)> f;
+    };
+
+struct METTSResult
+    {
+    //Names of the observables, in the order given
+    std::vector<std::string> names;
+    //Values of each observable on the METTS of
+    //all chains (chain 0 first)
+    std::vector<Stats> stats;
+    //chain_stats[c][o]: values of observable o on
+    //the METTS of chain c
+    std::vector<std::vector<Stats>> chain_stats;
+
+    //Statistics of the observable with the given name
+    Stats const&
+    operator()(std::string const& name) const;
+    };
+
+//
+// Run Markov chains of METTS starting from psi0
+// (usually a product state). Each step evolves the
+// current state with evolve, measures the observables
+// on it (after the first "NWarm" steps), and collapses
+// it into the next product state.
+//
+// The chains are independent and run in parallel.
+// Chain c draws its random numbers from
+// taskRandomStream("StreamOffset"+c), so results do
+// not depend on "NThread" or on which thread runs
+// a chain.
+//
+// Collapsing in the Z basis keeps the QNs of psi0
+// (the METTS sample the states of those QNs only).
+// Alternating Z and X collapses samples all states
+// and has shorter autocorrelation times, but needs
+// sites of dimension 2 without QNs.
+//
+// Args:
+// "NChain" (default 1) - number of chains
+// "NMETTS" (default 100) - measured steps per chain
+// "NWarm" (default 5) - steps per chain done before
+//         measuring
+// "NThread" (default hardwareThreads()) - number of
+//           chains run at the same time
+// "Basis" (default "Z") - collapse basis: "Z", "X" or
+//         "Alternate" (Z on odd and X on even steps)
+// "StreamOffset" (default 0) - first random stream
+// "Quiet" (default true) - if false, print each step
+//
+METTSResult
+metts(MPS const& psi0,
+      METTSEvolver const& evolve,
+      std::vector<METTSObservable> const& obs,
+      Args const& args = Args::global());
+
+} //namespace itensor
+
+#endif
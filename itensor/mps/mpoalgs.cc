@@ -16,6 +16,9 @@
 #include "itensor/util/print_macro.h"
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/localop.h"
+#include "itensor/contractnetwork.h"
+#include "itensor/util/cputime.h"
+#include "itensor/util/telemetry.h"
 
 namespace itensor {
 
@@ -125,11 +128,28 @@ fitApplyMPOImpl(MPS const& psi,
                 MPS & res,
                 Args const& args = Args::global());
 
+void
+applyMPOTelemetry(std::string const& method,
+                  MPS const& res,
+                  cpu_time const& start)
+    {
+    if(!telemetryOn()) return;
+    auto t = start.sincemark();
+    auto r = TelemetryRecord("apply_mpo");
+    r.add("method",method)
+     .add("length",length(res))
+     .add("max_bond_dim",long(maxLinkDim(res)))
+     .add("wall",t.wall)
+     .add("cpu",t.time);
+    emitTelemetry(std::move(r));
+    }
+
 MPS
 applyMPO(MPO const& K,
          MPS const& x,
          Args args)
     {
+    auto start = cpu_time{};
     if( !x ) Error("Error in applyMPO, MPS is uninitialized.");
     if( !K ) Error("Error in applyMPO, MPO is uninitialized.");
 
@@ -157,6 +177,7 @@ applyMPO(MPO const& K,
         Error("applyMPO currently supports the following methods: 'DensityMatrix', 'Fit'");
         }
 
+    applyMPOTelemetry(method,res,start);
     return res;
     }
 
@@ -170,6 +191,7 @@ applyMPO(MPO const& K,
     if( !x ) Error("Error in applyMPO, MPS is uninitialized.");
     if( !K ) Error("Error in applyMPO, MPO is uninitialized.");
     if( !x0 ) Error("Error in applyMPO, guess MPS is uninitialized.");
+    auto start = cpu_time{};
 
     auto method = args.getString("Method","Fit");
     if(!args.defined("RespectDegenerate")) args.add("RespectDegenerate",true);
@@ -182,6 +204,7 @@ applyMPO(MPO const& K,
     else
         Error("applyMPO currently supports the following methods: 'DensityMatrix', 'Fit'");
 
+    applyMPOTelemetry(method,res,start);
     return res;
     }
 
@@ -242,17 +265,20 @@ densityMatrixApplyMPOImpl(MPO const& K,
     //Build environment tensors from the left
     if(verbose) print("Building environment tensors...");
     auto E = std::vector<ITensor>(N+1);
-    E[1] = psi(1)*K(1)*Kc(1)*psic(1);
-    for(int j = 2; j < N; ++j)
+    auto scratch = NetworkScratch{};
+    for(int j = 1; j < N; ++j)
         {
-        E[j] = E[j-1]*psi(j)*K(j)*Kc(j)*psic(j);
+        //E[0] is default constructed, so is skipped
+        contractNetwork({&E[j-1],&psi(j),&K(j),&Kc(j),&psic(j)},E[j],scratch);
         }
     if(verbose) println("done");
 
     //O is the representation of the product of K*psi in the new MPS basis
     auto O = psi(N)*K(N);
 
-    auto rho = E[N-1] * O * dag(prime(O,rand_plev));
+    auto Od = dag(prime(O,rand_plev));
+    auto rho = ITensor{};
+    contractNetwork({&E[N-1],&O,&Od},rho,scratch);
 
     ITensor U,D;
     auto ts = tags(linkIndex(psi,N-1));
@@ -261,7 +287,7 @@ densityMatrixApplyMPOImpl(MPO const& K,
 
     res.ref(N) = dag(U);
 
-    O = O*U*psi(N-1)*K(N-1);
+    contractNetwork({&O,&U,&psi(N-1),&K(N-1)},O,scratch);
 
     for(int j = N-1; j > 1; --j)
         {
@@ -276,10 +302,11 @@ densityMatrixApplyMPOImpl(MPO const& K,
             maxdim *= (ciw) ? dim(ciw) : 1l;
             dargs.add("MaxDim",maxdim);
             }
-        rho = E[j-1] * O * dag(prime(O,rand_plev));
+        Od = dag(prime(O,rand_plev));
+        contractNetwork({&E[j-1],&O,&Od},rho,scratch);
         ts = tags(linkIndex(psi,j-1));
         auto spec = diagPosSemiDef(rho,U,D,{dargs,"Tags=",ts});
-        O = O*U*psi(j-1)*K(j-1);
+        contractNetwork({&O,&U,&psi(j-1),&K(j-1)},O,scratch);
         res.ref(j) = dag(U);
         if(verbose) printfln("  j=%02d truncerr=%.2E dim=%d",j,spec.truncerr(),dim(commonIndex(U,D)));
         }
@@ -1453,9 +1453,13 @@ innerC(MPS const& psi,
 
     auto L = phi(1) * psidag(1);
     if(N == 1) return eltC(L);
-    for(auto i : range1(2,N) ) 
+    for(auto i : range1(2,N-1) ) 
         L = L * phi(i) * psidag(i);
-    return eltC(L);
+    L *= phi(N);
+    //Full contraction with psidag(N) is a dot product;
+    //dotC conjugates L, so use it only when L is real
+    if(!isComplex(L)) return dotC(L,psidag(N));
+    return eltC(L*psidag(N));
     }
 
 void
@@ -839,6 +839,84 @@ inner(MPS const& x,
       MPS const& y, 
       Real& re, Real& im);
 
+//
+// Expectation values <x|Op_j|x>/<x|x> of the site
+// operators named in opnames, on every site j:
+// res[n][j-1] is the value for opnames[n].
+// sites must have the site indices of x.
+// expect returns the real parts.
+//
+std::vector<std::vector<Real>>
+expect(SiteSet const& sites,
+       MPS const& x,
+       std::vector<std::string> const& opnames);
+
+std::vector<std::vector<Cplx>>
+expectC(SiteSet const& sites,
+        MPS const& x,
+        std::vector<std::string> const& opnames);
+
+//
+// Two-point correlation functions
+// C(i-1,j-1) = <x|Op1_i Op2_j|x>/<x|x> for all sites
+// i and j (for i == j the product "Op1*Op2" of the
+// operators on site i). sites must have the site
+// indices of x. correlationMatrix returns the real parts.
+//
+// If Op1 and Op2 are fermionic operators (names
+// starting with "C", such as "Cdag" or "Cup"),
+// Jordan-Wigner strings "F" are put on the sites
+// between i and j.
+//
+// Each row reuses the environments of the previous
+// column, so the whole matrix costs about N^2 operator
+// contractions with the MPS tensors. Rows are computed
+// in parallel.
+//
+// Args:
+// "NThread" (default hardwareThreads()) - number of
+//           rows computed at the same time
+//
+Matrix
+correlationMatrix(SiteSet const& sites,
+                  MPS const& x,
+                  std::string const& Op1,
+                  std::string const& Op2,
+                  Args const& args = Args::global());
+
+CMatrix
+correlationMatrixC(SiteSet const& sites,
+                   MPS const& x,
+                   std::string const& Op1,
+                   std::string const& Op2,
+                   Args const& args = Args::global());
+
+//
+// Draw nsample configurations of the sites of x, each
+// with probability |<s_1 s_2 ... s_N|x>|^2/<x|x>.
+// res[n][j-1] is the state (1,2,...) of site j in
+// sample n.
+//
+// x is right-orthogonalized once, then samples are drawn
+// in batches one site at a time: the amplitudes of all
+// states of site j for a whole batch come from one matrix
+// product of the site tensor with the left vectors of the
+// batch. Batches run in parallel; batch b draws its random
+// numbers from taskRandomStream("StreamOffset"+b), so the
+// samples do not depend on "NThread".
+//
+// Args:
+// "BatchSize" (default 256) - samples per batch
+// "NThread" (default hardwareThreads()) - number of
+//           batches drawn at the same time
+// "StreamOffset" (default 0) - random stream of the
+//                first batch
+//
+std::vector<std::vector<int>>
+sample(MPS const& x,
+       int nsample,
+       Args const& args = Args::global());
+
 //Computes an MPS which has the same overlap with x_basis as x_to_fit,
 //but which differs from x_basis only on the first site, and has same index
 //structure as x_basis. Result is stored to x_to_fit on return.
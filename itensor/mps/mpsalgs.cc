@@ -17,6 +17,8 @@
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/localop.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/util/parallel_for.h"
+#include "itensor/util/random.h"
 #include "itensor/tensor/slicemat.h"
 
 namespace itensor {
@@ -247,4 +249,306 @@ totalQN(MPS const& psi)
     return div(psi(center));
     }
 
+namespace detail {
+
+//An operator name, or product "Op1*Op2*...",
+//with an odd number of fermionic factors
+bool
+isFermionicOp(string const& opname)
+    {
+    bool isf = false;
+    size_t b = 0;
+    while(b < opname.size())
+        {
+        auto e = std::min(opname.find('*',b),opname.size());
+        if(e > b && opname[b] == 'C') isf = !isf;
+        b = e+1;
+        }
+    return isf;
+    }
+
+//Orthogonality center of x at each site j, C[j],
+//and the right-orthogonal tensors B[j] of x with
+//the center at site 1; returns <x|x>
+Real
+centerTensors(MPS const& x,
+              vector<ITensor> & C,
+              vector<ITensor> & B)
+    {
+    auto N = length(x);
+    auto phi = x;
+    phi.position(1);
+    C.resize(N+1);
+    B.resize(N+1);
+    for(auto j : range1(N)) B[j] = phi(j);
+    for(auto j : range1(N))
+        {
+        phi.position(j);
+        C[j] = phi(j);
+        }
+    auto nrm = norm(C[1]);
+    if(nrm == 0.) Error("MPS has zero norm");
+    return nrm*nrm;
+    }
+
+} //namespace detail
+
+vector<vector<Cplx>>
+expectC(SiteSet const& sites,
+        MPS const& x,
+        vector<string> const& opnames)
+    {
+    auto N = length(x);
+    auto C = vector<ITensor>{},
+         B = vector<ITensor>{};
+    auto nrm2 = detail::centerTensors(x,C,B);
+    auto res = vector<vector<Cplx>>(opnames.size(),vector<Cplx>(N));
+    for(auto j : range1(N))
+        {
+        auto Cd = dag(prime(C[j],sites(j)));
+        for(auto n : range(opnames.size()))
+            {
+            res[n][j-1] = eltC(Cd*op(sites,opnames[n],j)*C[j])/nrm2;
+            }
+        }
+    return res;
+    }
+
+vector<vector<Real>>
+expect(SiteSet const& sites,
+       MPS const& x,
+       vector<string> const& opnames)
+    {
+    auto z = expectC(sites,x,opnames);
+    auto res = vector<vector<Real>>(z.size());
+    for(auto n : range(z.size()))
+    for(auto& v : z[n])
+        {
+        res[n].push_back(v.real());
+        }
+    return res;
+    }
+
+CMatrix
+correlationMatrixC(SiteSet const& sites,
+                   MPS const& x,
+                   string const& Op1,
+                   string const& Op2,
+                   Args const& args)
+    {
+    auto N = length(x);
+    auto nthread = args.getInt("NThread",hardwareThreads());
+    auto fermionic = detail::isFermionicOp(Op1);
+    if(fermionic != detail::isFermionicOp(Op2))
+        {
+        Error("correlationMatrix: Op1 and Op2 must both be fermionic or both be bosonic");
+        }
+    //<Op_i Op_j> = <Op_j Op_i> for commuting operators
+    auto mirror = (Op1 == Op2 && !fermionic);
+
+    auto C = vector<ITensor>{},
+         B = vector<ITensor>{};
+    auto nrm2 = detail::centerTensors(x,C,B);
+
+    //Site operators, and the tensors which close the
+    //environment after site j (Bd) or carry it on to
+    //site j+1 (Bt, Bl without and with a site operator)
+    auto O1 = vector<ITensor>(N+1),
+         O2 = vector<ITensor>(N+1),
+         F = vector<ITensor>(N+1),
+         Bd = vector<ITensor>(N+1),
+         Bt = vector<ITensor>(N+1),
+         Bl = vector<ITensor>(N+1);
+    for(auto j : range1(2,N))
+        {
+        auto l = commonIndex(B[j-1],B[j]);
+        O1[j] = op(sites,Op1,j);
+        O2[j] = op(sites,Op2,j);
+        Bd[j] = dag(prime(B[j],sites(j),l));
+        if(j == N) break;
+        Bt[j] = dag(prime(B[j]));
+        if(fermionic) F[j] = op(sites,"F",j);
+        else          Bl[j] = dag(prime(B[j],l,commonIndex(B[j],B[j+1])));
+        }
+
+    auto res = CMatrix(N,N);
+    parallelFor(N,nthread,[&](size_t r)
+        {
+        auto i = int(r)+1;
+        auto s = sites(i);
+        auto Cd = dag(prime(C[i],s));
+        res(i-1,i-1) = eltC(Cd*op(sites,Op1+"*"+Op2,i)*C[i])/nrm2;
+        if(i == N) return;
+        Cd.prime(commonIndex(C[i],B[i+1]));
+
+        //Row i: Op1 on site i and Op2 on sites j > i.
+        //Column i: Op2 on site i and Op1 on sites j > i
+        auto row = Cd*op(sites,fermionic ? Op1+"*F" : Op1,i)*C[i];
+        auto col = mirror ? ITensor{} : Cd*op(sites,fermionic ? "F*"+Op2 : Op2,i)*C[i];
+        for(auto j : range1(i+1,N))
+            {
+            res(i-1,j-1) = eltC(row*B[j]*O2[j]*Bd[j])/nrm2;
+            if(mirror) res(j-1,i-1) = res(i-1,j-1);
+            else       res(j-1,i-1) = eltC(col*B[j]*O1[j]*Bd[j])/nrm2;
+            if(j == N) break;
+            if(fermionic)
+                {
+                row = row*B[j]*F[j]*Bt[j];
+                col = col*B[j]*F[j]*Bt[j];
+                }
+            else
+                {
+                row = row*B[j]*Bl[j];
+                if(col) col = col*B[j]*Bl[j];
+                }
+            }
+        });
+    return res;
+    }
+
+Matrix
+correlationMatrix(SiteSet const& sites,
+                  MPS const& x,
+                  string const& Op1,
+                  string const& Op2,
+                  Args const& args)
+    {
+    auto z = correlationMatrixC(sites,x,Op1,Op2,args);
+    auto N = nrows(z);
+    auto res = Matrix(N,N);
+    for(auto i : range(N))
+    for(auto j : range(N))
+        {
+        res(i,j) = z(i,j).real();
+        }
+    return res;
+    }
+
+namespace detail {
+
+//
+// Site tensors of a right-orthogonal MPS as matrices
+// M[j] whose row k*m+c holds state k (0-based) of the
+// site and value c of the right link (dimension m), and
+// whose columns are the values of the left link
+//
+template<typename V>
+void
+sampleMatrices(MPS const& x,
+               vector<Mat<V>> & M,
+               vector<long> & d,
+               vector<long> & mr)
+    {
+    auto N = length(x);
+    M.resize(N+1);
+    d.assign(N+1,1);
+    mr.assign(N+1,1);
+    for(auto j : range1(N))
+        {
+        auto s = siteIndex(x,j);
+        auto is = vector<Index>{};
+        if(j < N) is.push_back(removeQNs(commonIndex(x(j),x(j+1))));
+        is.push_back(removeQNs(s));
+        if(j > 1) is.push_back(removeQNs(commonIndex(x(j-1),x(j))));
+        auto T = permute(removeQNs(x(j)),IndexSet(is));
+        d[j] = dim(s);
+        mr[j] = (j < N) ? dim(is.front()) : 1;
+        auto ml = (j > 1) ? dim(is.back()) : 1;
+        M[j] = Mat<V>(d[j]*mr[j],ml);
+        auto* p = M[j].data();
+        T.visit([&p](V v) { *p++ = v; });
+        }
+    }
+
+//Draw samples first,...,first+nb-1 of res
+template<typename V>
+void
+sampleBatch(vector<Mat<V>> const& M,
+            vector<long> const& d,
+            vector<long> const& mr,
+            RandomStream & rng,
+            size_t first,
+            size_t nb,
+            vector<vector<int>> & res)
+    {
+    auto N = int(M.size())-1;
+    //Normalized left vectors of the samples, one per column
+    auto L = Mat<V>(1,nb);
+    for(auto n : range(nb)) L(0,n) = 1.;
+    auto W = Mat<V>{};
+    auto p = vector<Real>{};
+    for(auto j : range1(N))
+        {
+        auto m = mr[j];
+        W = Mat<V>(d[j]*m,nb);
+        mult(M[j],L,W);
+        auto nL = Mat<V>(m,nb);
+        for(auto n : range(nb))
+            {
+            p.assign(d[j],0.);
+            Real tot = 0.;
+            for(auto k : range(d[j]))
+                {
+                for(auto c : range(m)) p[k] += std::norm(W(k*m+c,n));
+                tot += p[k];
+                }
+            auto r = tot*rng.uniform();
+            long k = 0;
+            for(Real cum = p[0]; k+1 < d[j] && cum <= r; cum += p[++k]) { }
+            //States of zero probability are never chosen
+            while(p[k] <= 0. && k > 0) --k;
+            res[first+n][j-1] = 1+int(k);
+            auto f = 1./std::sqrt(p[k]);
+            for(auto c : range(m)) nL(c,n) = f*W(k*m+c,n);
+            }
+        L = std::move(nL);
+        }
+    }
+
+template<typename V>
+void
+sampleImpl(MPS const& x,
+           vector<vector<int>> & res,
+           Args const& args)
+    {
+    auto nsample = res.size();
+    auto bsize = size_t(std::max(1L,args.getInt("BatchSize",256)));
+    auto nthread = args.getInt("NThread",hardwareThreads());
+    auto offset = args.getInt("StreamOffset",0);
+
+    auto M = vector<Mat<V>>{};
+    auto d = vector<long>{},
+         mr = vector<long>{};
+    sampleMatrices(x,M,d,mr);
+
+    auto nbatch = (nsample+bsize-1)/bsize;
+    parallelFor(nbatch,nthread,[&](size_t b)
+        {
+        auto rng = taskRandomStream(offset+b);
+        auto first = b*bsize;
+        auto nb = std::min(bsize,nsample-first);
+        sampleBatch(M,d,mr,rng,first,nb,res);
+        });
+    }
+
+} //namespace detail
+
+vector<vector<int>>
+sample(MPS const& x,
+       int nsample,
+       Args const& args)
+    {
+    auto N = length(x);
+    auto psi = x;
+    psi.position(1);
+    auto nrm = norm(psi(1));
+    if(nrm == 0.) Error("sample: MPS has zero norm");
+    psi.ref(1) /= nrm;
+
+    auto res = vector<vector<int>>(std::max(nsample,0),vector<int>(N));
+    if(isComplex(psi)) detail::sampleImpl<Cplx>(psi,res,args);
+    else               detail::sampleImpl<Real>(psi,res,args);
+    return res;
+    }
+
 } //namespace itensor
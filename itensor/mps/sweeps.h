@@ -122,6 +122,19 @@ class Sweeps
     SweepSetter<int> 
     niter();
 
+    //Number of bits (32 or 64, default 64) of the floating
+    //point precision used for dense real matrix products
+    //during sweep sw (see gemmSinglePrecision())
+    int 
+    precision(int sw) const { return precision_.at(sw); }
+    void 
+    setprecision(int sw, int val) { precision_.at(sw) = val; }
+
+    //Use as sweeps.precision() = 32,32,64; 
+    //(first two sweeps in single precision, all remaining in double)
+    SweepSetter<int> 
+    precision();
+
     void
     read(std::istream& s);
 
@@ -138,7 +151,8 @@ class Sweeps
 
     std::vector<int> maxdim_,
                      mindim_,
-                     niter_;
+                     niter_,
+                     precision_;
     std::vector<Real> cutoff_,
                       noise_;
     int nsweep_;
@@ -359,6 +373,9 @@ noise() { return SweepSetter<Real>(noise_); }
 SweepSetter<int> inline Sweeps::
 niter() { return SweepSetter<int>(niter_); }
 
+SweepSetter<int> inline Sweeps::
+precision() { return SweepSetter<int>(precision_); }
+
 void inline Sweeps::
 nsweep(int val)
     { 
@@ -402,12 +419,14 @@ init(Args args)
     auto cutoff = args.getReal("Cutoff");
     auto noise = args.getReal("Noise",0.);
     auto niter = args.getInt("Niter",2);
+    auto precision = args.getInt("Precision",64);
 
     mindim_ = std::vector<int>(nsweep_+1,min_dim);
     maxdim_ = std::vector<int>(nsweep_+1,max_dim);
     cutoff_ = std::vector<Real>(nsweep_+1,cutoff);
     niter_ = std::vector<int>(nsweep_+1,niter);
     noise_ = std::vector<Real>(nsweep_+1,noise);
+    precision_ = std::vector<int>(nsweep_+1,precision);
     } //Sweeps::init
 
 void inline Sweeps::
@@ -423,6 +442,7 @@ tableInit(InputGroup& table)
     cutoff_ = std::vector<Real>(nsweep_+1,0);
     niter_ = std::vector<int>(nsweep_+1,0);
     noise_ = std::vector<Real>(nsweep_+1,0);
+    precision_ = std::vector<int>(nsweep_+1,64);
 
     //printfln("Got nsweep_=%d",nsweep_);
     table.SkipLine(); //SkipLine so we can have a table key
@@ -451,26 +471,51 @@ tableInit(InputGroup& table)
 
     } //Sweeps::tableInit
 
+//Written first by Sweeps::write, in place of the
+//size of maxdim_ which begins the original format.
+//It is followed by a format version number.
+size_t constexpr
+sweeps_format_marker = size_t(-1);
+
 void inline Sweeps::
 write(std::ostream& s) const
     {
+    itensor::write(s,sweeps_format_marker);
+    itensor::write(s,int(1));
     itensor::write(s,maxdim_);
     itensor::write(s,mindim_);
     itensor::write(s,cutoff_);
     itensor::write(s,niter_);
     itensor::write(s,noise_);
     itensor::write(s,nsweep_);
+    itensor::write(s,precision_);
     }
 
 void inline Sweeps::
 read(std::istream& s)
     {
-    itensor::read(s,maxdim_);
+    auto size = size_t(0);
+    itensor::read(s,size);
+    auto version = 0;
+    if(size == sweeps_format_marker)
+        {
+        itensor::read(s,version);
+        itensor::read(s,maxdim_);
+        }
+    else
+        {
+        //Original format without a version:
+        //size is the size of maxdim_
+        maxdim_.resize(size);
+        s.read((char*)maxdim_.data(),sizeof(int)*size);
+        }
     itensor::read(s,mindim_);
     itensor::read(s,cutoff_);
     itensor::read(s,niter_);
     itensor::read(s,noise_);
     itensor::read(s,nsweep_);
+    if(version >= 1) itensor::read(s,precision_);
+    else             precision_ = std::vector<int>(nsweep_+1,64);
     }
 
 inline std::ostream&
@@ -479,8 +524,10 @@ operator<<(std::ostream& s, const Sweeps& swps)
     s << "Sweeps:\n";
     for(int sw = 1; sw <= swps.nsweep(); ++sw)
         {
-        s << format("%d  MaxDim=%d, MinDim=%d, Cutoff=%.1E, Niter=%d, Noise=%.1E\n",
+        s << format("%d  MaxDim=%d, MinDim=%d, Cutoff=%.1E, Niter=%d, Noise=%.1E",
               sw,swps.maxdim(sw),swps.mindim(sw),swps.cutoff(sw),swps.niter(sw),swps.noise(sw));
+        if(swps.precision(sw) != 64) s << format(", Precision=%d",swps.precision(sw));
+        s << "\n";
         }
     return s;
     }
@@ -19,6 +19,8 @@
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/bondgate.h"
 #include "itensor/mps/TEvolObserver.h"
+#include "itensor/util/cputime.h"
+#include "itensor/util/telemetry.h"
 
 namespace itensor {
 
@@ -81,6 +83,8 @@ gateTEvol(Iterable const& gatelist,
     Real tsofar = 0;
     for(auto tt : range1(nt))
         {
+        auto step_time = cpu_time{};
+        auto step_truncerr = 0.;
         auto g = gatelist.begin();
         while(g != gatelist.end())
             {
@@ -99,19 +103,22 @@ gateTEvol(Iterable const& gatelist,
                 //before applying current gate
                 if(ni1 >= i2)
                     {
-                    psi.svdBond(i1,AA,Fromleft,args);
+                    auto spec = psi.svdBond(i1,AA,Fromleft,args);
+                    step_truncerr = std::max(step_truncerr,spec.truncerr());
                     psi.position(ni1); //does no work if position already ni1
                     }
                 else
                     {
-                    psi.svdBond(i1,AA,Fromright,args);
+                    auto spec = psi.svdBond(i1,AA,Fromright,args);
+                    step_truncerr = std::max(step_truncerr,spec.truncerr());
                     psi.position(ni2); //does no work if position already ni2
                     }
                 }
             else
                 {
                 //No next gate to analyze, just restore MPS form
-                psi.svdBond(i1,AA,Fromright,args);
+                auto spec = psi.svdBond(i1,AA,Fromright,args);
+                step_truncerr = std::max(step_truncerr,spec.truncerr());
                 }
             }
 
@@ -122,6 +129,20 @@ gateTEvol(Iterable const& gatelist,
 
         tsofar += tstep;
 
+        if(telemetryOn())
+            {
+            auto st = step_time.sincemark();
+            auto r = TelemetryRecord("gate_tevol");
+            r.add("step",tt)
+             .add("time",tsofar)
+             .add("norm",tot_norm)
+             .add("max_bond_dim",long(maxLinkDim(psi)))
+             .add("max_truncerr",step_truncerr)
+             .add("wall",st.wall)
+             .add("cpu",st.time);
+            emitTelemetry(std::move(r));
+            }
+
         args.add("TimeStepNum",tt);
         args.add("Time",tsofar);
         args.add("TotalTime",ttotal);
@@ -46,40 +46,52 @@ svdImpl(ITensor const& A,
         ITensor & V,
         Args args)
     {
-    if( args.defined("Minm") )
+    static const auto Minm = ArgName("Minm");
+    static const auto MinDim = ArgName("MinDim");
+    static const auto Maxm = ArgName("Maxm");
+    static const auto MaxDim = ArgName("MaxDim");
+    static const auto Truncate = ArgName("Truncate");
+    static const auto SVDThreshold = ArgName("SVDThreshold");
+    static const auto Cutoff = ArgName("Cutoff");
+    static const auto DoRelCutoff = ArgName("DoRelCutoff");
+    static const auto AbsoluteCutoff = ArgName("AbsoluteCutoff");
+    static const auto ShowEigs = ArgName("ShowEigs");
+    static const auto ComputeQNs = ArgName("ComputeQNs");
+
+    if( args.defined(Minm) )
       {
-      if( args.defined("MinDim") )
+      if( args.defined(MinDim) )
         {
         Global::warnDeprecated("Args Minm and MinDim are both defined. Minm is deprecated in favor of MinDim, MinDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Minm is deprecated in favor of MinDim.");
-        args.add("MinDim",args.getInt("Minm"));
+        args.add(MinDim,args.getInt(Minm));
         }
       }
 
-    if( args.defined("Maxm") )
+    if( args.defined(Maxm) )
       {
-      if( args.defined("MaxDim") )
+      if( args.defined(MaxDim) )
         {
         Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
+        args.add(MaxDim,args.getInt(Maxm));
         }
       }
 
-    auto do_truncate = args.getBool("Truncate");
-    auto thresh = args.getReal("SVDThreshold",1E-3);
-    auto cutoff = args.getReal("Cutoff",MIN_CUT);
-    auto maxdim = args.getInt("MaxDim",MAX_DIM);
-    auto mindim = args.getInt("MinDim",1);
-    auto doRelCutoff = args.getBool("DoRelCutoff",true);
-    auto absoluteCutoff = args.getBool("AbsoluteCutoff",false);
-    auto show_eigs = args.getBool("ShowEigs",false);
+    auto do_truncate = args.getBool(Truncate);
+    auto thresh = args.getReal(SVDThreshold,1E-3);
+    auto cutoff = args.getReal(Cutoff,MIN_CUT);
+    auto maxdim = args.getInt(MaxDim,MAX_DIM);
+    auto mindim = args.getInt(MinDim,1);
+    auto doRelCutoff = args.getBool(DoRelCutoff,true);
+    auto absoluteCutoff = args.getBool(AbsoluteCutoff,false);
+    auto show_eigs = args.getBool(ShowEigs,false);
     auto litagset = getTagSet(args,"LeftTags","Link,U");
     auto ritagset = getTagSet(args,"RightTags","Link,V");
     if( litagset == ritagset ) Error("In SVD, must specify different tags for the new left and right indices (with Args 'LeftTags' and 'RightTags')");
@@ -126,12 +138,12 @@ svdImpl(ITensor const& A,
         if(show_eigs) 
             {
             auto showargs = args;
-            showargs.add("Cutoff",cutoff);
-            showargs.add("MaxDim",maxdim);
-            showargs.add("MinDim",mindim);
-            showargs.add("Truncate",do_truncate);
-            showargs.add("DoRelCutoff",doRelCutoff);
-            showargs.add("AbsoluteCutoff",absoluteCutoff);
+            showargs.add(Cutoff,cutoff);
+            showargs.add(MaxDim,maxdim);
+            showargs.add(MinDim,mindim);
+            showargs.add(Truncate,do_truncate);
+            showargs.add(DoRelCutoff,doRelCutoff);
+            showargs.add(AbsoluteCutoff,absoluteCutoff);
             showEigs(probs,truncerr,A.scale(),showargs);
             }
         
@@ -166,7 +178,7 @@ svdImpl(ITensor const& A,
         }
     else
         {
-        auto compute_qn = args.getBool("ComputeQNs",false);
+        auto compute_qn = args.getBool(ComputeQNs,false);
 
         auto blocks = doTask(GetBlocks<T>{A.inds(),uI,vI},A.store());
 
@@ -246,12 +258,12 @@ svdImpl(ITensor const& A,
         if(show_eigs) 
             {
             auto showargs = args;
-            showargs.add("Cutoff",cutoff);
-            showargs.add("MaxDim",maxdim);
-            showargs.add("MinDim",mindim);
-            showargs.add("Truncate",do_truncate);
-            showargs.add("DoRelCutoff",doRelCutoff);
-            showargs.add("AbsoluteCutoff",absoluteCutoff);
+            showargs.add(Cutoff,cutoff);
+            showargs.add(MaxDim,maxdim);
+            showargs.add(MinDim,mindim);
+            showargs.add(Truncate,do_truncate);
+            showargs.add(DoRelCutoff,doRelCutoff);
+            showargs.add(AbsoluteCutoff,absoluteCutoff);
             showEigs(probs,truncerr,A.scale(),showargs);
             }
 
@@ -432,22 +444,27 @@ svdOrd2(ITensor const& A,
         ITensor & V,
         Args args)
     {
-    if( args.defined("Maxm") )
+    static const auto Maxm = ArgName("Maxm");
+    static const auto MaxDim = ArgName("MaxDim");
+    static const auto Cutoff = ArgName("Cutoff");
+    static const auto Truncate = ArgName("Truncate");
+
+    if( args.defined(Maxm) )
       {
-      if( args.defined("MaxDim") )
+      if( args.defined(MaxDim) )
         {
         Global::warnDeprecated("Args Maxm and MaxDim are both defined. Maxm is deprecated in favor of MaxDim, MaxDim will be used.");
         }
       else
         {
         Global::warnDeprecated("Arg Maxm is deprecated in favor of MaxDim.");
-        args.add("MaxDim",args.getInt("Maxm"));
+        args.add(MaxDim,args.getInt(Maxm));
         }
       }
 
-    auto do_truncate = args.defined("Cutoff") || args.defined("MaxDim");
-    if(not args.defined("Truncate")) 
-        args.add("Truncate",do_truncate);
+    auto do_truncate = args.defined(Cutoff) || args.defined(MaxDim);
+    if(not args.defined(Truncate)) 
+        args.add(Truncate,do_truncate);
 
     if(A.order() != 2) 
         {
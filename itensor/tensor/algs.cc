@@ -20,6 +20,7 @@
 #include "itensor/tensor/algs.h"
 #include "itensor/util/iterate.h"
 #include "itensor/global.h"
+#include "itensor/util/perfcounters.h"
 
 using std::move;
 using std::sqrt;
@@ -30,9 +31,24 @@ using std::tie;
 namespace itensor {
 
 namespace detail {
+    //Estimated flops of symmetric eigensolvers: 4N^3/3 for
+    //the reduction to tridiagonal form, plus about 2N^2 per 
+    //eigenvector back-transformed (all of them: 9N^3 with
+    //QR iteration); complex arithmetic costs about 4 times more
+    double
+    hermitianDiagFlops(int N, int nvec, bool cplx)
+        {
+        double n = N;
+        auto f = 4.*n*n*n/3.;
+        if(nvec == N) f = 9.*n*n*n;
+        else          f += 2.*n*n*nvec;
+        return cplx ? 4*f : f;
+        }
+
     int
     hermitianDiag(int N, Real *Udata, Real *ddata)
         {
+        auto perf = PerfScope(PerfFactorize,hermitianDiagFlops(N,N,false));
         LAPACK_INT info = 0;
         dsyev_wrapper('V','U',N,Udata,ddata,info);
         return info;
@@ -40,8 +56,25 @@ namespace detail {
     int
     hermitianDiag(int N, Cplx *Udata,Real *ddata)
         {
+        auto perf = PerfScope(PerfFactorize,hermitianDiagFlops(N,N,true));
         return zheev_wrapper(N,Udata,ddata);
         }
+    int
+    hermitianDiag(int N, Real *Mdata, int nvec, Real *Udata, Real *ddata)
+        {
+        auto perf = PerfScope(PerfFactorize,hermitianDiagFlops(N,nvec,false));
+        if(nvec == 0) return dsyevr_wrapper('N',N,Mdata,0,0,ddata,nullptr);
+        if(nvec == N) return dsyevr_wrapper('V',N,Mdata,0,0,ddata,Udata);
+        return dsyevr_wrapper('V',N,Mdata,1,nvec,ddata,Udata);
+        }
+    int
+    hermitianDiag(int N, Cplx *Mdata, int nvec, Cplx *Udata, Real *ddata)
+        {
+        auto perf = PerfScope(PerfFactorize,hermitianDiagFlops(N,nvec,true));
+        if(nvec == 0) return zheevr_wrapper('N',N,Mdata,0,0,ddata,nullptr);
+        if(nvec == N) return zheevr_wrapper('V',N,Mdata,0,0,ddata,Udata);
+        return zheevr_wrapper('V',N,Mdata,1,nvec,ddata,Udata);
+        }
 
 } //namespace detail
 
@@ -149,6 +182,10 @@ diagGeneralRef(MatRefc<value_type> const& M,
     {
     auto N = ncols(M);
     if(N < 1) throw std::runtime_error("diagGeneral: 0 dimensional matrix");
+    //About 25N^3 flops for the nonsymmetric QR algorithm
+    //with eigenvectors
+    auto flops = 25.*N*N*N;
+    auto perf = PerfScope(PerfFactorize,isCplx<value_type>() ? 4*flops : flops);
     if(N != nrows(M))
         {
         printfln("M is %dx%d",nrows(M),ncols(M));
@@ -173,17 +210,15 @@ diagGeneralRef(MatRefc<value_type> const& M,
     struct Diag
         {
         LAPACK_INT static
-        call(LAPACK_INT N, Real const* Mdata, Real *Ldata, Real *Rdata, Real *drdata, Real *didata)
+        call(LAPACK_INT N, Real const* Mdata, char cl, Real *Ldata, char cr, Real *Rdata, Real *drdata, Real *didata)
             {
-            auto cl = (Ldata==nullptr) ? 'N' : 'V';
-            return dgeev_wrapper(cl,'V',N,Mdata,drdata,didata,Ldata,Rdata);
+            return dgeev_wrapper(cl,cr,N,Mdata,drdata,didata,Ldata,Rdata);
             }
         LAPACK_INT static
-        call(LAPACK_INT N, Cplx const* Mdata, Cplx *Ldata, Cplx *Rdata, Real *drdata, Real *didata)
+        call(LAPACK_INT N, Cplx const* Mdata, char cl, Cplx *Ldata, char cr, Cplx *Rdata, Real *drdata, Real *didata)
             {
             auto d = std::vector<Cplx>(N);
-            auto cl = (Ldata==nullptr) ? 'N' : 'V';
-            auto info = zgeev_wrapper(cl,'V',N,Mdata,d.data(),Ldata,Rdata);
+            auto info = zgeev_wrapper(cl,cr,N,Mdata,d.data(),Ldata,Rdata);
             for(size_t n = 0ul; n < d.size(); ++n)
                 {
                 *drdata = d[n].real();
@@ -197,9 +232,16 @@ diagGeneralRef(MatRefc<value_type> const& M,
 
     auto R = Mat<value_type>(N,N);
     auto L = Mat<value_type>{};
-    if(Lr && Li) resize(L,N,N);
-
-    auto info = Diag::call(N,M.data(),L.data(),R.data(),dr.data(),di.data());
+    auto cl = (Lr && Li) ? 'V' : 'N';
+    if(cl == 'V') resize(L,N,N);
+
+    //If M is transposed, the data passed to LAPACK is that
+    //of M^T. The right (left) eigenvectors of M are the complex
+    //conjugates of the left (right) eigenvectors of M^T, so 
+    //compute those instead of copying M into a non-transposed matrix
+    auto trans = isTransposed(M);
+    auto info = trans ? Diag::call(N,M.data(),'V',R.data(),cl,L.data(),dr.data(),di.data())
+                      : Diag::call(N,M.data(),cl,L.data(),'V',R.data(),dr.data(),di.data());
     if(info != 0) 
         {
         //println("M = \n",M);
@@ -249,13 +291,13 @@ diagGeneralRef(MatRefc<value_type> const& M,
             }
         };
 
-    auto Rref = isTransposed(M) ? transpose(R) : makeRef(R);
-    Unpack::call(makeRef(di),makeRef(Rr),makeRef(Ri),Rref);
+    Unpack::call(makeRef(di),makeRef(Rr),makeRef(Ri),makeRef(R));
+    if(trans) Ri *= -1;
 
     if(L) 
         {
-        auto Lref = isTransposed(M) ? transpose(L) : makeRef(L);
-        Unpack::call(makeRef(di),makeRef(Lr),makeRef(Li),Lref);
+        Unpack::call(makeRef(di),makeRef(Lr),makeRef(Li),makeRef(L));
+        if(trans) Li *= -1;
         Error("Inverse step not fully implemented");
         //for(auto n : range(N))
         //    {
@@ -594,6 +636,7 @@ SVDRef(MatRefc<T> const& M,
        MatRef<T>  const& V,
        Real thresh)
     {
+    auto perf = PerfScope(PerfFactorize);
     SVDRefImpl(M,U,D,V,thresh);
     }
 template void SVDRef(MatRefc<Real> const&,MatRef<Real> const&, VectorRef const&, MatRef<Real> const&,Real);
@@ -52,6 +52,39 @@ diagHermitian(MatM && M,
               MatU && U,
               Vecd && d);
 
+//
+// Version of diagHermitian computing only the
+// nvec largest eigenvalues of M and their
+// eigenvectors (using the MRRR algorithm).
+// On return U is nrows(M) x nvec and d has
+// size nvec.
+//
+template<class MatM, class MatU,class Vecd,
+         class = stdx::require<
+         hasMatRange<MatM>,
+         hasMatRange<MatU>,
+         hasVecRange<Vecd>
+         >>
+void
+diagHermitian(MatM && M,
+              MatU && U,
+              Vecd && d,
+              long nvec);
+
+//
+// eigvalsHermitian computes only the 
+// eigenvalues of a Hermitian matrix M,
+// returned in decreasing order in d
+//
+template<class MatM,class Vecd,
+         class = stdx::require<
+         hasMatRange<MatM>,
+         hasVecRange<Vecd>
+         >>
+void
+eigvalsHermitian(MatM && M,
+                 Vecd && d);
+
 // compute eigenvalues
 // and right eigenvectors
 template<class MatM, class MatV,class Vecd,
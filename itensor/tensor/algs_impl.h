@@ -54,6 +54,13 @@ copyNegElts(Iter mre,
     int
     hermitianDiag(int N, Cplx *Udata,Real *ddata);
 
+    //Partial versions: Mdata is overwritten,
+    //nvec==0 means compute eigenvalues only
+    int
+    hermitianDiag(int N, Real *Mdata, int nvec, Real *Udata, Real *ddata);
+    int
+    hermitianDiag(int N, Cplx *Mdata, int nvec, Cplx *Udata, Real *ddata);
+
 } //namespace detail
 
 template<class MatM, 
@@ -106,6 +113,100 @@ diagHermitian(MatM && M,
     if(isTransposed(M)) conjugate(U);
     }
 
+template<class MatM, 
+         class MatU,
+         class Vecd,
+         class>
+void
+diagHermitian(MatM && M,
+              MatU && U,
+              Vecd && d,
+              long nvec)
+    {
+    using Mval = typename stdx::decay_t<MatM>::value_type;
+    using Uval = typename stdx::decay_t<MatU>::value_type;
+    static_assert((isReal<Mval>() && isReal<Uval>()) || (isCplx<Mval>() && isCplx<Uval>()),
+                  "M and U must be both real or both complex in diagHermitian");
+    auto N = ncols(M);
+    if(N < 1) throw std::runtime_error("diagHermitian: 0 dimensional matrix");
+    if(N != nrows(M))
+        {
+        printfln("M is %dx%d",nrows(M),ncols(M));
+        throw std::runtime_error("diagHermitian: Input Matrix must be square");
+        }
+    if(nvec < 1 || nvec > long(N))
+        {
+        printfln("nvec = %d, N = %d",nvec,N);
+        throw std::runtime_error("diagHermitian: number of eigenvectors out of range");
+        }
+
+    resize(U,N,nvec);
+    resize(d,nvec);
+
+#ifdef DEBUG
+    if(!isContiguous(U))
+        throw std::runtime_error("diagHermitian: U must be contiguous");
+    if(!isContiguous(d))
+        throw std::runtime_error("diagHermitian: d must be contiguous");
+#endif
+
+    //Set Mc = -M so eigenvalues will be sorted from largest to smallest
+    auto Mc = std::vector<Uval>(N*N);
+    auto Mcref = makeMatRef(Mc.data(),Mc.size(),N,N);
+    if(isContiguous(M)) detail::copyNegElts(M.data(),Mcref);
+    else                detail::copyNegElts(M.cbegin(),Mcref);
+
+    auto info = detail::hermitianDiag(N,Mc.data(),nvec,U.data(),d.data());
+    if(info != 0) 
+        {
+        throw std::runtime_error("Error condition in diagHermitian");
+        }
+
+    //Correct the signs of the eigenvalues:
+    d *= -1;
+    //If M is transposed, we actually just computed the decomposition of
+    //M^T=M^*, so conjugate U to compensate for this
+    if(isTransposed(M)) conjugate(U);
+    }
+
+template<class MatM, 
+         class Vecd,
+         class>
+void
+eigvalsHermitian(MatM && M,
+                 Vecd && d)
+    {
+    using Mval = typename stdx::decay_t<MatM>::value_type;
+    auto N = ncols(M);
+    if(N < 1) throw std::runtime_error("eigvalsHermitian: 0 dimensional matrix");
+    if(N != nrows(M))
+        {
+        printfln("M is %dx%d",nrows(M),ncols(M));
+        throw std::runtime_error("eigvalsHermitian: Input Matrix must be square");
+        }
+
+    resize(d,N);
+
+#ifdef DEBUG
+    if(!isContiguous(d))
+        throw std::runtime_error("eigvalsHermitian: d must be contiguous");
+#endif
+
+    //Set Mc = -M so eigenvalues will be sorted from largest to smallest
+    auto Mc = std::vector<Mval>(N*N);
+    auto Mcref = makeMatRef(Mc.data(),Mc.size(),N,N);
+    if(isContiguous(M)) detail::copyNegElts(M.data(),Mcref);
+    else                detail::copyNegElts(M.cbegin(),Mcref);
+
+    auto info = detail::hermitianDiag(N,Mc.data(),0,static_cast<Mval*>(nullptr),d.data());
+    if(info != 0) 
+        {
+        throw std::runtime_error("Error condition in eigvalsHermitian");
+        }
+
+    d *= -1;
+    }
+
 template<typename V>
 void
 diagGeneralRef(MatRefc<V> const& M,
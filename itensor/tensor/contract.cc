@@ -23,15 +23,24 @@
 #include "itensor/detail/gcounter.h"
 #include "itensor/tensor/mat.h"
 #include "itensor/tensor/contract.h"
+#include "itensor/tensor/lapack_wrap.h"
 #include "itensor/tensor/slicemat.h"
 #include "itensor/tensor/sliceten.h"
 #include "itensor/indexset.h"
 #include "itensor/global.h"
+#include "itensor/util/perfcounters.h"
+#include "itensor/util/vector_no_init.h"
 
 using std::vector;
 
 namespace itensor {
 
+//Buffers for permuted copies of the tensors being contracted
+using ContractScratch = vector_no_init<Real>;
+
+ContractScratch
+contractScratch() { return ContractScratch(ContractScratch::allocator_type(MemScratch)); }
+
 template<typename T>
 void
 printv(const vector<T>& t)
@@ -243,16 +252,18 @@ struct CProps
             TenRefc<R,V2> B,
             TenRefc<R,common_type<V1,V2>> C)
         {
-        // Optimizations TODO
+        // Notes on index order
         //
-        // o Add "automatic C" mode where index order of C can be
-        //   unspecified, and will be chosen so as not to require
-        //   permuting C at the end.
+        // o An "automatic C" order, where the index order of C is left
+        //   to the contraction engine, is the order computed by contractIS
+        //   (uncontracted indices of A, then of B, each in their original
+        //   order), which ITensor-level contractions use for C. For this
+        //   order PC below is always trivial, since A and B are only ever
+        //   permuted to put their uncontracted indices in the order of C.
         //
-        // o If trailing extent(j)==1 dimensions at end of A, B, or C indices
-        //   (as often the case for ITensors with m==1 indices),
-        //   have CProps resize ai, bi, and ci accordingly to avoid
-        //   looping over these.
+        // o Indices with extent(j)==1 (as often the case for ITensors with 
+        //   m==1 indices) are removed by contract before CProps sees them
+        //   (see stripUnitExtents) to avoid looping over them.
         //
 
         computePerms();
@@ -730,14 +741,18 @@ class CABqueue
     };
 
 
+//Version of contract taking scratch space d
+//used to hold permuted copies of A, B, and C;
+//d is resized if it is too small
 template<typename range_t, typename VA, typename VB>
 void 
 contract(CProps const& p,
          TenRefc<range_t,VA> A,
          TenRefc<range_t,VB> B,
          TenRef<range_t,common_type<VA,VB>>  C,
-         Real alpha = 1.,
-         Real beta = 0.)
+         Real alpha,
+         Real beta,
+         ContractScratch & d)
     {
     using VC = common_type<VA,VB>;
     auto Apsize = p.permuteA() ? dim(p.newArange) : 0ul;
@@ -747,7 +762,12 @@ contract(CProps const& p,
     auto Bbufsize = isCplx(B) ? 2ul*Bpsize : Bpsize;
     auto Cbufsize = isCplx(C) ? 2ul*Cpsize : Cpsize;
 
-    auto d = std::vector<Real>(Abufsize+Bbufsize+Cbufsize);
+    if(d.size() < Abufsize+Bbufsize+Cbufsize) 
+        {
+        perfAddBytesAllocated(sizeof(Real)*(Abufsize+Bbufsize+Cbufsize-d.size()));
+        d.resize(Abufsize+Bbufsize+Cbufsize);
+        }
+    perfAddBytesPermuted(PerfContract,sizeof(Real)*(Abufsize+Bbufsize+Cbufsize));
     auto ab = MAKE_SAFE_PTR(d.data(),d.size());
     auto bb = ab+Abufsize;
     auto cb = bb+Bbufsize;
@@ -812,17 +832,39 @@ contract(CProps const& p,
             }
         }
 
-    gemm(aref,bref,cref,alpha,beta);
+    //When C must be permuted, gemm writes alpha*A*B into the
+    //(uninitialized) scratch newC and beta*C is added back below
+    gemm(aref,bref,cref,alpha,p.permuteC() ? 0. : beta);
 
     if(p.permuteC())
         {
 #ifdef DEBUG
         if(isTrivial(p.PC)) Error("Calling permute in contract with a trivial permutation");
 #endif
-        C &= permute(newC,p.PC);
+        if(beta == 0)
+            {
+            C &= permute(newC,p.PC);
+            }
+        else
+            {
+            transform(makeRefc(permute(newC,p.PC)),C,[beta](VC x, VC& c){ c = x+beta*c; });
+            }
         }
     }
 
+template<typename range_t, typename VA, typename VB>
+void 
+contract(CProps const& p,
+         TenRefc<range_t,VA> A,
+         TenRefc<range_t,VB> B,
+         TenRef<range_t,common_type<VA,VB>>  C,
+         Real alpha = 1.,
+         Real beta = 0.)
+    {
+    auto d = contractScratch();
+    contract(p,A,B,C,alpha,beta,d);
+    }
+
 template<typename R, typename T1, typename T2>
 void 
 contractScalar(T1 a, 
@@ -840,6 +882,40 @@ contractScalar(T1 a,
         transform(PB,C,[fac,beta](T2 b, T3& c){ c = fac*b+beta*c; });
     }
 
+template<typename RangeT>
+bool
+hasUnitExtent(RangeT const& R)
+    {
+    for(decltype(R.order()) j = 0; j < R.order(); ++j)
+        if(R.extent(j) == 1) return true;
+    return false;
+    }
+
+//Make a Range nR and labels nind with the indices of
+//R having extent 1 removed. Since these indices don't 
+//affect the layout of the data, nR can be used in place
+//of R to avoid permuting or looping over them.
+template<typename RangeT>
+void
+stripUnitExtents(RangeT const& R,
+                 Labels const& ind,
+                 Range & nR,
+                 Labels & nind)
+    {
+    long nr = 0;
+    for(decltype(R.order()) j = 0; j < R.order(); ++j)
+        if(R.extent(j) != 1) ++nr;
+    auto rb = RangeBuilder(nr);
+    nind.clear();
+    for(decltype(R.order()) j = 0; j < R.order(); ++j)
+        if(R.extent(j) != 1)
+            {
+            rb.nextIndStr(R.extent(j),R.stride(j));
+            nind.push_back(ind[j]);
+            }
+    nR = rb.build();
+    }
+
 template<typename RangeT, typename VA, typename VB>
 void 
 contract(TenRefc<RangeT,VA> A, Labels const& ai, 
@@ -849,6 +925,25 @@ contract(TenRefc<RangeT,VA> A, Labels const& ai,
          Real alpha,
          Real beta)
     {
+    auto perf = PerfScope(PerfContract);
+    if(hasUnitExtent(A.range()) || hasUnitExtent(B.range()) || hasUnitExtent(C.range()))
+        {
+        Range nAr,
+              nBr,
+              nCr;
+        Labels nai,
+               nbi,
+               nci;
+        stripUnitExtents(A.range(),ai,nAr,nai);
+        stripUnitExtents(B.range(),bi,nBr,nbi);
+        stripUnitExtents(C.range(),ci,nCr,nci);
+        contract(TenRefc<Range,VA>(A.store(),&nAr),nai,
+                 TenRefc<Range,VB>(B.store(),&nBr),nbi,
+                 TenRef<Range,common_type<VA,VB>>(C.store(),&nCr),nci,
+                 alpha,beta);
+        return;
+        }
+
     if(ai.empty()) 
         {
         contractScalar(*A.data(),B,bi,C,ci,alpha,beta);
@@ -981,6 +1076,159 @@ computeMultInfo(Labels const& ai,
     return I;
     }
 
+template<typename VA, typename VB>
+void 
+contractBatch(Range const& Arange, Labels const& ai, 
+              Range const& Brange, Labels const& bi, 
+              Range const& Crange, Labels const& ci,
+              std::vector<BatchContraction<VA,VB>> const& batch,
+              Real alpha)
+    {
+    if(batch.empty()) return;
+    auto perf = PerfScope(PerfContract);
+    auto Asize = dim(Arange),
+         Bsize = dim(Brange),
+         Csize = dim(Crange);
+    auto makeRefs = [&](BatchContraction<VA,VB> const& b)
+        {
+        return std::make_tuple(makeTenRef(b.A,Asize,&Arange),
+                               makeTenRef(b.B,Bsize,&Brange),
+                               makeTenRef(b.C,Csize,&Crange));
+        };
+    if(ai.empty() || bi.empty())
+        {
+        for(auto& b : batch)
+            {
+            auto [A,B,C] = makeRefs(b);
+            contract(A,ai,B,bi,C,ci,alpha,b.beta);
+            }
+        return;
+        }
+    CProps props(ai,bi,ci);
+        {
+        auto [A,B,C] = makeRefs(batch.front());
+        props.compute(A,B,C);
+        }
+    auto d = contractScratch();
+    for(auto& b : batch)
+        {
+        auto [A,B,C] = makeRefs(b);
+        contract<Range,VA,VB>(props,A,B,C,alpha,b.beta,d);
+        }
+    }
+template void
+contractBatch(Range const&, Labels const&, Range const&, Labels const&, Range const&, Labels const&,
+              std::vector<BatchContraction<Real,Real>> const&, Real);
+template void
+contractBatch(Range const&, Labels const&, Range const&, Labels const&, Range const&, Labels const&,
+              std::vector<BatchContraction<Cplx,Real>> const&, Real);
+template void
+contractBatch(Range const&, Labels const&, Range const&, Labels const&, Range const&, Labels const&,
+              std::vector<BatchContraction<Real,Cplx>> const&, Real);
+template void
+contractBatch(Range const&, Labels const&, Range const&, Labels const&, Range const&, Labels const&,
+              std::vector<BatchContraction<Cplx,Cplx>> const&, Real);
+
+namespace detail {
+
+//Sum of conj(A[j*incA])*B[j*incB] for j = 0,...,n-1
+Cplx
+dotLine(long n, Real const* A, long incA, Real const* B, long incB)
+    {
+    return ddot_wrapper(n,A,incA,B,incB);
+    }
+Cplx
+dotLine(long n, Cplx const* A, long incA, Cplx const* B, long incB)
+    {
+    return zdotc_wrapper(n,A,incA,B,incB);
+    }
+Cplx
+dotLine(long n, Real const* A, long incA, Cplx const* B, long incB)
+    {
+    auto pB = reinterpret_cast<Real const*>(B);
+    return Cplx(ddot_wrapper(n,A,incA,pB,2*incB),
+                ddot_wrapper(n,A,incA,pB+1,2*incB));
+    }
+Cplx
+dotLine(long n, Cplx const* A, long incA, Real const* B, long incB)
+    {
+    auto pA = reinterpret_cast<Real const*>(A);
+    return Cplx(ddot_wrapper(n,pA,2*incA,B,incB),
+                -ddot_wrapper(n,pA+1,2*incA,B,incB));
+    }
+
+} //namespace detail
+
+template<typename VA, typename VB>
+Cplx
+dotStrided(VA const* A,
+           VB const* B,
+           std::vector<long> const& dims,
+           std::vector<long> const& Astrides,
+           std::vector<long> const& Bstrides,
+           int nthread)
+    {
+    auto r = dims.size();
+    if(r == 0) return detail::dotLine(1,A,1,B,1);
+    long nline = 1;
+    for(auto j : range(1,r)) nline *= dims[j];
+    if(dims[0] == 0 || nline == 0) return 0.;
+
+    //Sum lines b,...,e-1, where line n has
+    //indices 1,...,r-1 given by the digits of n
+    auto sumLines = [&](long b, long e)
+        {
+        auto ind = std::vector<long>(r,0);
+        long offA = 0,
+             offB = 0;
+        auto n = b;
+        for(auto j : range(1,r))
+            {
+            ind[j] = n%dims[j];
+            n /= dims[j];
+            offA += ind[j]*Astrides[j];
+            offB += ind[j]*Bstrides[j];
+            }
+        auto res = Cplx(0.);
+        for(auto l = b; l < e; ++l)
+            {
+            res += detail::dotLine(dims[0],A+offA,Astrides[0],B+offB,Bstrides[0]);
+            for(auto j : range(1,r))
+                {
+                ++ind[j];
+                offA += Astrides[j];
+                offB += Bstrides[j];
+                if(ind[j] < dims[j]) break;
+                offA -= ind[j]*Astrides[j];
+                offB -= ind[j]*Bstrides[j];
+                ind[j] = 0;
+                }
+            }
+        return res;
+        };
+
+    //Below this many elements per thread,
+    //starting threads is not worth it
+    const long min_chunk = 1l << 17;
+    auto nchunk = std::max(1l,std::min(long(std::max(nthread,1)),(dims[0]*nline)/min_chunk));
+    nchunk = std::min(nchunk,nline);
+    if(nchunk == 1) return sumLines(0,nline);
+    auto chunk = (nline+nchunk-1)/nchunk;
+    auto futs = std::vector<std::future<Cplx>>{};
+    for(auto b = chunk; b < nline; b += chunk)
+        {
+        auto e = std::min(nline,b+chunk);
+        futs.push_back(std::async(std::launch::async,sumLines,b,e));
+        }
+    auto res = sumLines(0,std::min(nline,chunk));
+    for(auto& f : futs) res += f.get();
+    return res;
+    }
+template Cplx dotStrided(Real const*,Real const*,std::vector<long> const&,std::vector<long> const&,std::vector<long> const&,int);
+template Cplx dotStrided(Real const*,Cplx const*,std::vector<long> const&,std::vector<long> const&,std::vector<long> const&,int);
+template Cplx dotStrided(Cplx const*,Real const*,std::vector<long> const&,std::vector<long> const&,std::vector<long> const&,int);
+template Cplx dotStrided(Cplx const*,Cplx const*,std::vector<long> const&,std::vector<long> const&,std::vector<long> const&,int);
+
 template<typename RangeT>
 void 
 contractloop(TenRefc<RangeT> A, Labels const& ai, 
@@ -40,6 +40,45 @@ contract(Ten<R,VA> const& A, Labels const& ai,
          Real alpha = 1.,
          Real beta = 0.);
 
+//
+// A single contraction C = alpha*A*B + beta*C within
+// a batch, where A, B, and C point to tensor data
+// whose layout is given by the ranges passed to contractBatch
+//
+template<typename VA, typename VB>
+struct BatchContraction
+    {
+    VA const* A = nullptr;
+    VB const* B = nullptr;
+    common_type<VA,VB>* C = nullptr;
+    Real beta = 0.;
+
+    BatchContraction() { }
+
+    BatchContraction(VA const* A_,
+                     VB const* B_,
+                     common_type<VA,VB>* C_,
+                     Real beta_ = 0.)
+      : A(A_), B(B_), C(C_), beta(beta_)
+        { }
+    };
+
+//
+// Perform a batch of contractions which all share
+// the same ranges and index labels, such as the
+// same-shaped blocks of QN conserving tensors.
+// The analysis of the index pattern and the scratch
+// space used for permutations are set up only once
+// for the whole batch.
+//
+template<typename VA, typename VB>
+void 
+contractBatch(Range const& Arange, Labels const& ai, 
+              Range const& Brange, Labels const& bi, 
+              Range const& Crange, Labels const& ci,
+              std::vector<BatchContraction<VA,VB>> const& batch,
+              Real alpha = 1.);
+
 template<typename range_type>
 void 
 contractloop(TenRefc<range_type> A, Labels const& ai, 
@@ -47,6 +86,23 @@ contractloop(TenRefc<range_type> A, Labels const& ai,
              TenRef<range_type>  C, Labels const& ci,
              Args const& args = Args::global());
 
+//
+// Sum over all elements of conj(A)*B, for A and B with
+// the same extents dims, stored with strides Astrides
+// and Bstrides (so B can be a permutation of A).
+// Lines along the first dimension are summed by
+// ddot/zdotc; for more than about 10^5 elements, the
+// lines are split among up to nthread threads.
+//
+template<typename VA, typename VB>
+Cplx
+dotStrided(VA const* A,
+           VB const* B,
+           std::vector<long> const& dims,
+           std::vector<long> const& Astrides,
+           std::vector<long> const& Bstrides,
+           int nthread = 1);
+
 template<typename range_type>
 void 
 contractloop(Ten<range_type> const& A, Labels const& ai, 
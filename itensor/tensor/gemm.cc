@@ -16,6 +16,7 @@
 #include "itensor/tensor/lapack_wrap.h"
 #include "itensor/tensor/slicemat.h"
 #include "itensor/util/safe_ptr.h"
+#include "itensor/util/perfcounters.h"
 
 namespace itensor {
 
@@ -249,6 +250,54 @@ gemm_impl(MatRefc<Real> A,
                  C.data());
     }
 
+//
+// Simple loop kernel for very small matrices
+// (such as blocks of QN conserving tensors)
+// where the overhead of calling BLAS dominates
+//
+template<typename VA, typename VB, typename VC>
+void
+gemm_small(MatRefc<VA> A,
+           MatRefc<VB> B,
+           MatRef<VC>  C,
+           Real alpha,
+           Real beta)
+    {
+    auto m = nrows(A),
+         n = ncols(B),
+         k = ncols(A);
+    auto pa = A.data();
+    auto pb = B.data();
+    auto pc = C.data();
+    auto ars = A.range().rs,
+         acs = A.range().cs,
+         brs = B.range().rs,
+         bcs = B.range().cs;
+    //C is never transposed here (see gemm below)
+    auto ccs = C.range().cs;
+    for(decltype(n) j = 0; j < n; ++j)
+        {
+        auto cj = pc+j*ccs;
+        if(beta == 0.)
+            {
+            for(decltype(m) i = 0; i < m; ++i) cj[i] = 0.;
+            }
+        else if(beta != 1.)
+            {
+            for(decltype(m) i = 0; i < m; ++i) cj[i] *= beta;
+            }
+        for(decltype(k) l = 0; l < k; ++l)
+            {
+            auto b = alpha*pb[l*brs+j*bcs];
+            auto al = pa+l*acs;
+            for(decltype(m) i = 0; i < m; ++i)
+                {
+                cj[i] += al[i*ars]*b;
+                }
+            }
+        }
+    }
+
 // C = alpha*A*B + beta*C
 template<typename VA, typename VB>
 void
@@ -274,16 +323,25 @@ gemm(MatRefc<VA> A,
         throw std::runtime_error("mult(_add) AxB -> C: matrix C incompatible");
         }
 #endif
+    //2mnk flops for real A and B, doubled for each complex factor
+    auto flops = 2.*nrows(A)*ncols(B)*ncols(A);
+    if(isCplx<VA>()) flops *= 2;
+    if(isCplx<VB>()) flops *= 2;
+    auto perf = PerfScope(PerfGemm,flops);
+
+    auto small = nrows(A)*ncols(B)*ncols(A) <= SMALL_GEMM_SIZE;
     if(isTransposed(C))
         {
         //Do C = Bt*At instead of Ct=A*B
         //Recall that C.data() points to elements of C, not C.t()
         //regardless of whether C.transpose()==true or false
-        gemm_impl(transpose(B),transpose(A),transpose(C),alpha,beta);
+        if(small) gemm_small(transpose(B),transpose(A),transpose(C),alpha,beta);
+        else      gemm_impl(transpose(B),transpose(A),transpose(C),alpha,beta);
         }
     else
         {
-        gemm_impl(A,B,C,alpha,beta);
+        if(small) gemm_small(A,B,C,alpha,beta);
+        else      gemm_impl(A,B,C,alpha,beta);
         }
     }
 template void gemm(MatRefc<Real>, MatRefc<Real>, MatRef<Real>,Real,Real);
@@ -13,7 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <algorithm>
 #include "itensor/tensor/lapack_wrap.h"
+#include "itensor/util/vector_no_init.h"
 //#include "itensor/tensor/permutecplx.h"
 
 namespace itensor {
@@ -110,6 +112,63 @@ zdotc_wrapper(LAPACK_INT N,
     return Cplx{};
     }
 
+bool&
+gemmSinglePrecision()
+    {
+    thread_local bool single = false;
+    return single;
+    }
+
+//
+// sgemm
+//
+void 
+gemm_wrapper(bool transa, 
+             bool transb,
+             LAPACK_INT m,
+             LAPACK_INT n,
+             LAPACK_INT k,
+             float alpha,
+             float const* A,
+             float const* B,
+             float beta,
+             float * C)
+    {
+    LAPACK_INT lda = m,
+               ldb = k;
+#ifdef ITENSOR_USE_CBLAS
+    auto at = CblasNoTrans,
+         bt = CblasNoTrans;
+    if(transa)
+        {
+        at = CblasTrans;
+        lda = k;
+        }
+    if(transb)
+        {
+        bt = CblasTrans;
+        ldb = n;
+        }
+    cblas_sgemm(CblasColMajor,at,bt,m,n,k,alpha,A,lda,B,ldb,beta,C,m);
+#else
+    auto *pA = const_cast<float*>(A);
+    auto *pB = const_cast<float*>(B);
+    char at = 'N';
+    char bt = 'N';
+    if(transa)
+        {
+        at = 'T';
+        lda = k;
+        }
+    if(transb)
+        {
+        bt = 'T';
+        ldb = n;
+        }
+    F77NAME(sgemm)(&at,&bt,&m,&n,&k,&alpha,pA,&lda,pB,&ldb,&beta,C,&m);
+#endif
+    }
+
 //
 // dgemm
 //
@@ -125,6 +184,25 @@ gemm_wrapper(bool transa,
              LAPACK_REAL beta,
              LAPACK_REAL * C)
     {
+    if(gemmSinglePrecision())
+        {
+        //Single precision copies of A, B and C, allocated 
+        //per call as scratch storage (see storage_alloc.h)
+        //so that none is kept once the product is done
+        auto sA = size_t(m)*size_t(k),
+             sB = size_t(k)*size_t(n),
+             sC = size_t(m)*size_t(n);
+        auto d = vector_no_init<float>(sA+sB+sC,uninitialized_allocator<float>(MemScratch));
+        auto fA = d.data(),
+             fB = fA+sA,
+             fC = fB+sB;
+        std::copy(A,A+sA,fA);
+        std::copy(B,B+sB,fB);
+        if(beta != 0.) std::copy(C,C+sC,fC);
+        gemm_wrapper(transa,transb,m,n,k,float(alpha),fA,fB,float(beta),fC);
+        std::copy(fC,fC+sC,C);
+        return;
+        }
     LAPACK_INT lda = m,
                ldb = k;
 #ifdef ITENSOR_USE_CBLAS
@@ -345,6 +423,64 @@ dsyev_wrapper(char jobz,        //if jobz=='V', compute eigs and evecs
 #endif
     }
 
+//
+// dsyevr
+//
+LAPACK_INT
+dsyevr_wrapper(char jobz,         //if jobz=='V', compute eigs and evecs
+               LAPACK_INT n,      //number of cols of A
+               LAPACK_REAL* A,    //symmetric matrix A, destroyed on return
+               LAPACK_INT il,     //index of smallest eigenvalue to compute
+               LAPACK_INT iu,     //index of largest eigenvalue to compute
+               LAPACK_REAL* eigs, //eigenvalues on return, ascending order
+               LAPACK_REAL* Z)    //eigenvectors on return (n x number of eigs)
+    {
+    char range = (il > 0) ? 'I' : 'A';
+    char uplo = 'U';
+    LAPACK_INT lda = n;
+    LAPACK_INT ldz = n;
+    LAPACK_REAL vl = 0,
+                vu = 0;
+    //abstol <= 0 means use default tolerance
+    LAPACK_REAL abstol = -1;
+    LAPACK_INT m = 0;
+    LAPACK_INT info = 0;
+    auto nz = (range == 'I') ? (iu-il+1) : n;
+    std::vector<LAPACK_INT> isuppz(2*std::max(LAPACK_INT(1),nz));
+    //w must have size n even if fewer eigenvalues are requested
+    std::vector<LAPACK_REAL> w(n);
+    //Z is not referenced when jobz=='N'
+    LAPACK_REAL zdummy = 0;
+    auto pZ = (jobz == 'V') ? Z : &zdummy;
+
+    //Compute optimal workspace sizes
+    LAPACK_INT lwork = -1,
+               liwork = -1;
+    LAPACK_REAL wkopt = 0;
+    LAPACK_INT iwkopt = 0;
+#ifdef PLATFORM_acml
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&n,A,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),&wkopt,&lwork,&iwkopt,&liwork,&info,1,1,1);
+#else
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&n,A,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),&wkopt,&lwork,&iwkopt,&liwork,&info);
+#endif
+    if(info != 0) return info;
+    lwork = LAPACK_INT(wkopt);
+    liwork = iwkopt;
+    std::vector<LAPACK_REAL> work(lwork);
+    std::vector<LAPACK_INT> iwork(liwork);
+#ifdef PLATFORM_acml
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&n,A,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),work.data(),&lwork,iwork.data(),&liwork,&info,1,1,1);
+#else
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&n,A,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),work.data(),&lwork,iwork.data(),&liwork,&info);
+#endif
+    std::copy(w.begin(),w.begin()+m,eigs);
+    return info;
+    }
+
 //
 // dscal
 //
@@ -553,6 +689,71 @@ zheev_wrapper(LAPACK_INT      N,  //number of cols of A
     return info;
     }
 
+//
+// zheevr
+//
+LAPACK_INT
+zheevr_wrapper(char jobz,         //if jobz=='V', compute eigs and evecs
+               LAPACK_INT n,      //number of cols of A
+               Cplx* A,           //Hermitian matrix A, destroyed on return
+               LAPACK_INT il,     //index of smallest eigenvalue to compute
+               LAPACK_INT iu,     //index of largest eigenvalue to compute
+               LAPACK_REAL* eigs, //eigenvalues on return, ascending order
+               Cplx* Z)           //eigenvectors on return (n x number of eigs)
+    {
+    static_assert(sizeof(LAPACK_COMPLEX)==sizeof(Cplx),"LAPACK_COMPLEX and itensor::Cplx have different size");
+    char range = (il > 0) ? 'I' : 'A';
+    char uplo = 'U';
+    LAPACK_INT lda = n;
+    LAPACK_INT ldz = n;
+    LAPACK_REAL vl = 0,
+                vu = 0;
+    //abstol <= 0 means use default tolerance
+    LAPACK_REAL abstol = -1;
+    LAPACK_INT m = 0;
+    LAPACK_INT info = 0;
+    auto nz = (range == 'I') ? (iu-il+1) : n;
+    std::vector<LAPACK_INT> isuppz(2*std::max(LAPACK_INT(1),nz));
+    //w must have size n even if fewer eigenvalues are requested
+    std::vector<LAPACK_REAL> w(n);
+    auto pA = reinterpret_cast<LAPACK_COMPLEX*>(A);
+    //Z is not referenced when jobz=='N'
+    LAPACK_COMPLEX zdummy;
+    auto pZ = (jobz == 'V') ? reinterpret_cast<LAPACK_COMPLEX*>(Z) : &zdummy;
+
+    //Compute optimal workspace sizes
+    LAPACK_INT lwork = -1,
+               lrwork = -1,
+               liwork = -1;
+    Cplx wkopt = 0;
+    auto pwkopt = reinterpret_cast<LAPACK_COMPLEX*>(&wkopt);
+    LAPACK_REAL rwkopt = 0;
+    LAPACK_INT iwkopt = 0;
+#ifdef PLATFORM_acml
+    F77NAME(zheevr)(&jobz,&range,&uplo,&n,pA,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),pwkopt,&lwork,&rwkopt,&lrwork,&iwkopt,&liwork,&info,1,1,1);
+#else
+    F77NAME(zheevr)(&jobz,&range,&uplo,&n,pA,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),pwkopt,&lwork,&rwkopt,&lrwork,&iwkopt,&liwork,&info);
+#endif
+    if(info != 0) return info;
+    lwork = LAPACK_INT(wkopt.real());
+    lrwork = LAPACK_INT(rwkopt);
+    liwork = iwkopt;
+    std::vector<LAPACK_COMPLEX> work(lwork);
+    std::vector<LAPACK_REAL> rwork(lrwork);
+    std::vector<LAPACK_INT> iwork(liwork);
+#ifdef PLATFORM_acml
+    F77NAME(zheevr)(&jobz,&range,&uplo,&n,pA,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),work.data(),&lwork,rwork.data(),&lrwork,iwork.data(),&liwork,&info,1,1,1);
+#else
+    F77NAME(zheevr)(&jobz,&range,&uplo,&n,pA,&lda,&vl,&vu,&il,&iu,&abstol,&m,w.data(),pZ,&ldz,
+                    isuppz.data(),work.data(),&lwork,rwork.data(),&lrwork,iwork.data(),&liwork,&info);
+#endif
+    std::copy(w.begin(),w.begin()+m,eigs);
+    return info;
+    }
+
 //
 // dsygv
 //
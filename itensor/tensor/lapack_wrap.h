@@ -209,6 +209,20 @@ void F77NAME(dgemm)(char*,char*,LAPACK_INT*,LAPACK_INT*,LAPACK_INT*,
             LAPACK_INT*,LAPACK_REAL*,LAPACK_REAL*,LAPACK_INT*);
 #endif
 
+//sgemm declaration
+#ifdef ITENSOR_USE_CBLAS
+void cblas_sgemm(const enum CBLAS_ORDER __Order,
+        const enum CBLAS_TRANSPOSE __TransA,
+        const enum CBLAS_TRANSPOSE __TransB, const int __M, const int __N,
+        const int __K, const float __alpha, const float *__A,
+        const int __lda, const float *__B, const int __ldb,
+        const float __beta, float *__C, const int __ldc);
+#else
+void F77NAME(sgemm)(char*,char*,LAPACK_INT*,LAPACK_INT*,LAPACK_INT*,
+            float*,float*,LAPACK_INT*,float*,
+            LAPACK_INT*,float*,float*,LAPACK_INT*);
+#endif
+
 //zgemm declaration
 #ifdef PLATFORM_openblas
 void cblas_zgemm(OPENBLAS_CONST enum CBLAS_ORDER Order, 
@@ -291,6 +305,20 @@ void F77NAME(dsyev)(const char* jobz, const char* uplo, const LAPACK_INT* n, dou
             LAPACK_INT* info );
 #endif
 
+#ifdef PLATFORM_acml
+void F77NAME(dsyevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, double *a, LAPACK_INT *lda,
+                     double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu, double *abstol, 
+                     LAPACK_INT *m, double *w, double *z, LAPACK_INT *ldz, LAPACK_INT *isuppz, 
+                     double *work, LAPACK_INT *lwork, LAPACK_INT *iwork, LAPACK_INT *liwork, 
+                     LAPACK_INT *info, LAPACK_INT jobz_len, LAPACK_INT range_len, LAPACK_INT uplo_len);
+#else
+void F77NAME(dsyevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, double *a, LAPACK_INT *lda,
+                     double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu, double *abstol, 
+                     LAPACK_INT *m, double *w, double *z, LAPACK_INT *ldz, LAPACK_INT *isuppz, 
+                     double *work, LAPACK_INT *lwork, LAPACK_INT *iwork, LAPACK_INT *liwork, 
+                     LAPACK_INT *info);
+#endif
+
 #ifdef ITENSOR_USE_CBLAS
 void cblas_dscal(const LAPACK_INT N, const LAPACK_REAL alpha, LAPACK_REAL* X,const LAPACK_INT incX);
 #else
@@ -350,6 +378,21 @@ void F77NAME(zheev)(char *jobz, char *uplo, LAPACK_INT *n, LAPACK_COMPLEX *a, LA
            LAPACK_INT *info);
 #endif
 
+#ifdef PLATFORM_acml
+void F77NAME(zheevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, LAPACK_COMPLEX *a, 
+                     LAPACK_INT *lda, double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu, 
+                     double *abstol, LAPACK_INT *m, double *w, LAPACK_COMPLEX *z, LAPACK_INT *ldz, 
+                     LAPACK_INT *isuppz, LAPACK_COMPLEX *work, LAPACK_INT *lwork, double *rwork, 
+                     LAPACK_INT *lrwork, LAPACK_INT *iwork, LAPACK_INT *liwork, LAPACK_INT *info,
+                     LAPACK_INT jobz_len, LAPACK_INT range_len, LAPACK_INT uplo_len);
+#else
+void F77NAME(zheevr)(char *jobz, char *range, char *uplo, LAPACK_INT *n, LAPACK_COMPLEX *a, 
+                     LAPACK_INT *lda, double *vl, double *vu, LAPACK_INT *il, LAPACK_INT *iu, 
+                     double *abstol, LAPACK_INT *m, double *w, LAPACK_COMPLEX *z, LAPACK_INT *ldz, 
+                     LAPACK_INT *isuppz, LAPACK_COMPLEX *work, LAPACK_INT *lwork, double *rwork, 
+                     LAPACK_INT *lrwork, LAPACK_INT *iwork, LAPACK_INT *liwork, LAPACK_INT *info);
+#endif
+
 
 #ifdef PLATFORM_acml
 void F77NAME(dsygv)(LAPACK_INT *itype, char *jobz, char *uplo, LAPACK_INT *n, double *a, 
@@ -432,6 +475,40 @@ zdotc_wrapper(LAPACK_INT N,
               Cplx const* Y,
               LAPACK_INT incy);
 
+//
+// If gemmSinglePrecision() is set to true, 
+// the dgemm version of gemm_wrapper (also used to 
+// emulate complex matrix products) converts its 
+// arguments to single precision and calls sgemm,
+// trading accuracy for speed, for example in the 
+// early sweeps of a DMRG calculation
+// (see the precision() schedule of Sweeps).
+// This only speeds up the matrix product itself:
+// tensors are still stored in double precision, and
+// each product allocates single precision copies of
+// its arguments as scratch storage (MemScratch), so
+// memory use and traffic go up rather than down.
+// The setting is per thread, so calculations running
+// on different threads do not affect each other.
+//
+bool&
+gemmSinglePrecision();
+
+//
+// sgemm
+//
+void
+gemm_wrapper(bool transa, 
+             bool transb,
+             LAPACK_INT m,
+             LAPACK_INT n,
+             LAPACK_INT k,
+             float alpha,
+             float const* A,
+             float const* B,
+             float beta,
+             float * C);
+
 //
 // dgemm
 //
@@ -504,6 +581,27 @@ dsyev_wrapper(char jobz,        //if jobz=='V', compute eigs and evecs
               LAPACK_REAL* eigs, //eigenvalues on return
               LAPACK_INT& info);  //error info
 
+//
+// dsyevr
+//
+// Selected eigenvalues and, optionally, eigenvectors of a
+// real symmetric matrix A using the MRRR algorithm.
+// If il > 0, only the eigenvalues with (1-based) indices
+// il through iu in ascending order are computed;
+// otherwise all eigenvalues are computed.
+//
+// Returns "info" integer
+//
+LAPACK_INT
+dsyevr_wrapper(char jobz,         //if jobz=='V', compute eigs and evecs
+                                  //if jobz=='N', only eigs
+               LAPACK_INT n,      //number of cols of A
+               LAPACK_REAL* A,    //symmetric matrix A, destroyed on return
+               LAPACK_INT il,     //index of smallest eigenvalue to compute
+               LAPACK_INT iu,     //index of largest eigenvalue to compute
+               LAPACK_REAL* eigs, //eigenvalues on return, ascending order
+               LAPACK_REAL* Z);   //eigenvectors on return (n x number of eigs)
+
 //
 // dscal
 //
@@ -611,6 +709,24 @@ zheev_wrapper(LAPACK_INT    N,  //number of cols of A
               Cplx        * A,  //matrix A, on return contains eigenvectors
               LAPACK_REAL * d); //eigenvalues on return
 
+//
+// zheevr
+//
+// Selected eigenvalues and, optionally, eigenvectors of a
+// complex Hermitian matrix A using the MRRR algorithm.
+// Arguments are the same as for dsyevr_wrapper above.
+//
+// Returns "info" integer
+//
+LAPACK_INT
+zheevr_wrapper(char jobz,         //if jobz=='V', compute eigs and evecs
+               LAPACK_INT n,      //number of cols of A
+               Cplx* A,           //Hermitian matrix A, destroyed on return
+               LAPACK_INT il,     //index of smallest eigenvalue to compute
+               LAPACK_INT iu,     //index of largest eigenvalue to compute
+               LAPACK_REAL* eigs, //eigenvalues on return, ascending order
+               Cplx* Z);          //eigenvectors on return (n x number of eigs)
+
 //
 // dsygv
 //
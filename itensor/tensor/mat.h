@@ -108,6 +108,11 @@ operator&=(CMatrixRef const& A, MatrixRefc const& B);
 void inline
 operator&=(MatrixRef const& A, Matrix const& B) { A &= makeRefc(B); }
 
+//Matrix products with nrows(A)*ncols(B)*ncols(A)
+//at most this size are computed by gemm using a
+//simple loop kernel instead of calling BLAS
+static const size_t SMALL_GEMM_SIZE = 256;
+
 // C = beta*C + alpha*A*B
 template<typename VA, typename VB>
 void
@@ -15,7 +15,11 @@
 //
 #include <cerrno>
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 #include "itensor/util/args.h"
 #include "itensor/util/error.h"
 #include "itensor/util/readwrite.h"
@@ -45,11 +49,86 @@ chopSpaceEq(std::string name)
     return name;
     }
 
+namespace detail {
+
+//Names are never removed; the deque keeps
+//the address of each name string fixed
+struct ArgNameTable
+    {
+    std::mutex mutex;
+    std::unordered_map<std::string,int> ids;
+    std::deque<std::string> names;
+    };
+
+ArgNameTable&
+argNameTable()
+    {
+    static auto* T = new ArgNameTable();
+    return *T;
+    }
+
+} //namespace detail
+
+ArgName::
+ArgName(const char* name)
+    {
+    intern(std::string(name));
+    }
+
+ArgName::
+ArgName(std::string const& name)
+    {
+    intern(name);
+    }
+
+void ArgName::
+intern(std::string key)
+    {
+    //Names seen before by this thread are
+    //found without locking the table
+    thread_local auto cache = std::unordered_map<std::string,ArgName>{};
+    auto c = cache.find(key);
+    if(c != cache.end())
+        {
+        *this = c->second;
+        return;
+        }
+    auto& T = detail::argNameTable();
+        {
+        std::lock_guard<std::mutex> lock(T.mutex);
+        auto [it,inserted] = T.ids.emplace(key,int(T.names.size()));
+        if(inserted) T.names.push_back(key);
+        id_ = it->second;
+        str_ = &T.names[id_];
+        }
+    cache.emplace(std::move(key),*this);
+    }
+
+std::string const& ArgName::
+str() const
+    {
+    static const auto empty = std::string();
+    return str_ ? *str_ : empty;
+    }
+
+ostream&
+operator<<(ostream& s, ArgName const& name)
+    {
+    return s << name.str();
+    }
+
+ArgName
+chopSpaceEq(ArgName const& name)
+    {
+    auto& s = name.str();
+    if(s.empty() || (s.back() != '=' && s.back() != ' ')) return name;
+    return ArgName(chopSpaceEq(s));
+    }
+
 
 Args::Val::
 Val()
     :
-    name_("Null"),
     type_(None),
     rval_(NAN)
     { }
@@ -57,7 +136,7 @@ Val()
 Args::Val::
 Val(const char* name)
     :
-    name_(chopSpaceEq(name)),
+    name_(chopSpaceEq(std::string(name))),
     type_(Boolean),
     rval_(1.0)
     { }
@@ -140,7 +219,9 @@ Val(Name const& name, Real rval)
 void Args::Val::
 read(std::istream& s)
     { 
-    itensor::read(s, name_);
+    auto name = std::string();
+    itensor::read(s, name);
+    name_ = ArgName(name);
     itensor::read(s, type_);
     if(type_ == String)
         itensor::read(s, sval_);
@@ -151,7 +232,7 @@ read(std::istream& s)
 void Args::Val::
 write(std::ostream& s) const
     { 
-    itensor::write(s, name_);
+    itensor::write(s, name_.str());
     itensor::write(s, type_);
     if(type_ == String)
         itensor::write(s, sval_);
@@ -163,7 +244,7 @@ void Args::Val::
 assertType(Type t) const
     {
     if(t != type_)
-        throw ITError("Wrong value type for option " + name_);
+        throw ITError("Wrong value type for option " + name_.str());
     }
 
 ostream& 
@@ -252,30 +333,49 @@ add(Name const& name, const std::string& sval) { add({name,sval}); }
 void Args::
 add(Name const& name, Real rval) { add({name,rval}); }
 
-bool Args::
-defined(Name const& name) const
+Args::storage_type& Args::
+mutableVals()
     {
-    for(auto& x : vals_)
+    if(!vals_) vals_ = std::make_shared<storage_type>();
+    else if(vals_.use_count() > 1) vals_ = std::make_shared<storage_type>(*vals_);
+    //Order after accesses by other threads through
+    //copies they have released (see isUniqueOwner)
+    else std::atomic_thread_fence(std::memory_order_acquire);
+    return *vals_;
+    }
+
+Args::Val const* Args::
+find(Name const& name) const
+    {
+    if(vals_)
         {
-        if(x.name() == name) return true;
+        for(auto& x : *vals_)
+            {
+            if(x.name() == name) return &x;
+            }
         }
 
-    if(isGlobal()) return false;
+    if(isGlobal()) return nullptr;
 
     //otherwise see if global Args contains it
-    return global().defined(name);
+    return global().find(name);
+    }
+
+bool Args::
+defined(Name const& name) const
+    {
+    return find(name) != nullptr;
     }
 
 // Remove an arg from the set - always succeeds
 void Args::
 remove(const Name& name)
     {
-    for(auto it = vals_.begin(); it != vals_.end(); ++it)
-        if(it->name() == name)
-            {
-            vals_.erase(it);
-            break;
-            }
+    if(!vals_) return;
+    auto has = [&name](Val const& x) { return x.name() == name; };
+    if(std::none_of(vals_->begin(),vals_->end(),has)) return;
+    auto& vals = mutableVals();
+    vals.erase(std::find_if(vals.begin(),vals.end(),has));
     }
 
 
@@ -283,7 +383,8 @@ void Args::
 add(Val const& val)
     {
     if(!val) return;
-    for(auto& x : vals_)
+    auto& vals = mutableVals();
+    for(auto& x : vals)
         //If already defined, replace
         if(x.name() == val.name()) 
             {
@@ -291,7 +392,7 @@ add(Val const& val)
             return;
             }
     //Otherwise add to the end
-    vals_.push_back(val);
+    vals.push_back(val);
     }
 
 void Args::
@@ -304,16 +405,9 @@ add(const char* ostring)
 const Args::Val& Args::
 get(Name const& name) const
     {
-    for(auto& x : vals_)
-        {
-        if(x.name() == name) return x;
-        }
-    //couldn't find the Val in this Args
-    if(isGlobal())
-        {
-        throw ITError("Requested option " + name + " not found");
-        }
-    return global().get(name);
+    auto* v = find(name);
+    if(!v) throw ITError("Requested option " + name.str() + " not found");
+    return *v;
     }
 
 bool Args::
@@ -325,8 +419,8 @@ getBool(Name const& name) const
 bool Args::
 getBool(Name const& name, bool default_value) const
     {
-    if(defined(name)) return get(name).boolVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->boolVal() : default_value;
     }
 
  
@@ -339,8 +433,8 @@ getString(Name const& name) const
 string const& Args::
 getString(Name const& name, string const& default_value) const
     {
-    if(defined(name)) return get(name).stringVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->stringVal() : default_value;
     }
 
 long Args::
@@ -352,8 +446,8 @@ getInt(Name const& name) const
 long Args::
 getInt(Name const& name, long default_value) const
     {
-    if(defined(name)) return get(name).intVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->intVal() : default_value;
     }
 
 size_t Args::
@@ -365,8 +459,8 @@ getSizeT(Name const& name) const
 size_t Args::
 getSizeT(Name const& name, long default_value) const
     {
-    if(defined(name)) return get(name).size_tVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->size_tVal() : default_value;
     }
 
 Real Args::
@@ -378,8 +472,8 @@ getReal(Name const& name) const
 Real Args::
 getReal(Name const& name, Real default_value) const
     {
-    if(defined(name)) return get(name).realVal();
-    return default_value;
+    auto* v = find(name);
+    return v ? v->realVal() : default_value;
     }
 
 void Args::
@@ -446,7 +540,14 @@ addByString(string ostring)
 Args& Args::
 operator+=(Args const& args)
     {
-    for(auto& x : args.vals_)
+    if(!args.vals_ || args.vals_ == vals_) return *this;
+    if(!vals_ && !isGlobal())
+        {
+        //Share the values of args
+        vals_ = args.vals_;
+        return *this;
+        }
+    for(auto& x : *args.vals_)
         {
         add(x);
         }
@@ -456,13 +557,15 @@ operator+=(Args const& args)
 void Args::
 read(std::istream& s)
     {
-    itensor::read(s,vals_);
+    auto vals = std::make_shared<storage_type>();
+    itensor::read(s,*vals);
+    vals_ = vals->empty() ? nullptr : std::move(vals);
     }
 
 void Args::
 write(std::ostream& s) const
     {
-    itensor::write(s,vals_);
+    itensor::write(s,vals_ ? *vals_ : storage_type{});
     }
 
 Args
@@ -493,8 +596,9 @@ operator<<(ostream & s, Args const& args)
     if(args.isGlobal()) s << "Global Args:\n";
     else                s << "Args: (only showing overrides of global args)\n";
 
-    for(auto& opt : args.vals_)
-        s << opt << "\n";
+    if(args.vals_)
+        for(auto& opt : *args.vals_)
+            s << opt << "\n";
 
     return s;
     }
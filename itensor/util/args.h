@@ -16,6 +16,8 @@
 #ifndef __ITENSOR_OPTION_H
 #define __ITENSOR_OPTION_H
 
+#include <iosfwd>
+#include <memory>
 #include <vector>
 #include <string>
 #include "math.h"
@@ -24,6 +26,56 @@
 
 namespace itensor {
 
+//
+// ArgName - interned name of a named argument
+//
+// Each distinct name is stored once in a global table
+// and identified by an integer id, so comparing two
+// ArgNames is a comparison of ids. An ArgName is
+// implicitly constructed from a string (looking it
+// up in the table).
+//
+// In code called very often, construct names once:
+//   static const auto MaxDim = ArgName("MaxDim");
+//   auto maxdim = args.getInt(MaxDim,1000);
+//
+
+class ArgName
+    {
+    int id_ = -1;
+    std::string const* str_ = nullptr;
+    public:
+
+    ArgName() { }
+
+    ArgName(const char* name);
+
+    ArgName(std::string const& name);
+
+    int
+    id() const { return id_; }
+
+    //Empty for a default-constructed ArgName
+    std::string const&
+    str() const;
+
+    explicit operator bool() const { return id_ >= 0; }
+
+    private:
+
+    void
+    intern(std::string key);
+    };
+
+bool inline
+operator==(ArgName const& a, ArgName const& b) { return a.id() == b.id(); }
+
+bool inline
+operator!=(ArgName const& a, ArgName const& b) { return a.id() != b.id(); }
+
+std::ostream&
+operator<<(std::ostream& s, ArgName const& name);
+
 //
 // Args - named argument system
 //
@@ -45,13 +97,15 @@ namespace itensor {
 //   func(T1 t1, T2 t2, ..., const Args& args = Args::global());
 //   which will incur essentially no overhead.
 //   If you intend to add or modify the args set, take it by value.
+//   Copies share their values until one of them is
+//   modified (copy-on-write), so copying is cheap.
 //
 
 class Args
     {
     class Val;
     public:
-    using Name = std::string;
+    using Name = ArgName;
     using storage_type = InfArray<Val,7ul>;
 
     Args();
@@ -218,6 +272,15 @@ class Args
     Val const&
     get(Name const& name) const;
 
+    //Returns nullptr if name is not defined here
+    //or in the global Args
+    Val const*
+    find(Name const& name) const;
+
+    //Values, copied first if shared with another Args
+    storage_type&
+    mutableVals();
+
     friend std::ostream& 
     operator<<(std::ostream & s, Val const& v);
 
@@ -297,7 +360,9 @@ class Args
 
         };
 
-    storage_type vals_;
+    //Null if no values were added; shared
+    //between copies until one is modified
+    std::shared_ptr<storage_type> vals_;
 
     };
 
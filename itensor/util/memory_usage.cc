@@ -0,0 +1,279 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include "itensor/util/memory_usage.h"
+#include "itensor/util/iterate.h"
+#include "itensor/util/print.h"
+
+namespace itensor {
+
+const char*
+memKindName(MemKind k)
+    {
+    switch(k)
+        {
+        case MemOther: return "Other";
+        case MemDense: return "Dense";
+        case MemQDense: return "QDense";
+        case MemDiag: return "Diag";
+        case MemQDiag: return "QDiag";
+        case MemScratch: return "Scratch";
+        default: return "Unknown";
+        }
+    }
+
+namespace detail {
+
+std::atomic<bool> memtrack_on(false);
+std::atomic<long> memtrack_entries(0);
+
+struct MemEntry
+    {
+    size_t bytes = 0;
+    MemKind kind = MemOther;
+    int tag = 0;
+    };
+
+struct MemTracker
+    {
+    std::mutex mutex;
+    std::unordered_map<void*,MemEntry> entries;
+    MemUsage total;
+    std::array<MemUsage,NMemKind> kinds;
+    //Tag 0 is the empty tag of untagged storage
+    std::vector<const char*> tagnames = {""};
+    std::vector<MemUsage> tags = {MemUsage{}};
+    size_t limit = 0;
+    };
+
+//Never destroyed, so that storage freed during
+//static destruction can still be recorded
+MemTracker&
+memTracker()
+    {
+    static auto* M = new MemTracker();
+    return *M;
+    }
+
+thread_local int current_tag = 0;
+
+void
+addLive(MemUsage& u, size_t bytes)
+    {
+    u.live += bytes;
+    u.peak = std::max(u.peak,u.live);
+    }
+
+void
+memTrackAlloc(void* p, size_t bytes, MemKind k)
+    {
+    if(p == nullptr) return;
+    auto& M = memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    auto e = MemEntry{bytes,k,current_tag};
+    auto [it,inserted] = M.entries.emplace(p,e);
+    if(!inserted)
+        {
+        //Stale entry: p was freed while nothing was tracked
+        auto& o = it->second;
+        M.total.live -= o.bytes;
+        M.kinds[o.kind].live -= o.bytes;
+        M.tags[o.tag].live -= o.bytes;
+        it->second = e;
+        }
+    else
+        {
+        memtrack_entries.fetch_add(1);
+        }
+    addLive(M.total,bytes);
+    addLive(M.kinds[k],bytes);
+    addLive(M.tags[e.tag],bytes);
+    }
+
+void
+memTrackFree(void* p)
+    {
+    auto& M = memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    auto it = M.entries.find(p);
+    if(it == M.entries.end()) return;
+    auto& e = it->second;
+    M.total.live -= e.bytes;
+    M.kinds[e.kind].live -= e.bytes;
+    M.tags[e.tag].live -= e.bytes;
+    M.entries.erase(it);
+    memtrack_entries.fetch_sub(1);
+    }
+
+void
+memTrackSetKind(void const* p, MemKind k)
+    {
+    auto& M = memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    auto it = M.entries.find(const_cast<void*>(p));
+    if(it == M.entries.end()) return;
+    auto& e = it->second;
+    if(e.kind == k) return;
+    M.kinds[e.kind].live -= e.bytes;
+    addLive(M.kinds[k],e.bytes);
+    e.kind = k;
+    }
+
+int
+memEnterScope(const char* tag)
+    {
+    auto& M = memTracker();
+    auto prev = current_tag;
+    std::lock_guard<std::mutex> lock(M.mutex);
+    auto n = 0ul;
+    for(; n < M.tagnames.size(); ++n)
+        {
+        if(std::strcmp(M.tagnames[n],tag) == 0) break;
+        }
+    if(n == M.tagnames.size())
+        {
+        M.tagnames.push_back(tag);
+        M.tags.emplace_back();
+        }
+    current_tag = n;
+    return prev;
+    }
+
+void
+memLeaveScope(int prev)
+    {
+    current_tag = prev;
+    }
+
+int&
+memCurrentTag() { return current_tag; }
+
+} //namespace detail
+
+void
+setMemoryTracking(bool val)
+    {
+    detail::memTracker();
+    detail::memtrack_on.store(val);
+    }
+
+MemoryReport
+memoryReport()
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    auto R = MemoryReport{};
+    R.total = M.total;
+    R.kinds = M.kinds;
+    for(auto n : range(M.tags.size()))
+        {
+        R.tags.emplace_back(M.tagnames[n],M.tags[n]);
+        }
+    return R;
+    }
+
+std::ostream&
+operator<<(std::ostream& s, MemoryReport const& R)
+    {
+    auto MB = [](size_t b) { return 1E-6*b; };
+    s << "-----------------------------------------------------\n";
+    s << format("Memory (MB):             Live = %.2f, Peak = %.2f",MB(R.total.live),MB(R.total.peak));
+    for(auto n : range(R.kinds.size()))
+        {
+        auto& u = R.kinds[n];
+        if(u.peak == 0) continue;
+        s << format("\n  %-22s Live = %.2f, Peak = %.2f",memKindName(MemKind(n)),MB(u.live),MB(u.peak));
+        }
+    for(auto& [tag,u] : R.tags)
+        {
+        if(u.peak == 0) continue;
+        auto name = tag.empty() ? std::string("(untagged)") : "\"" + tag + "\"";
+        s << format("\n  %-22s Live = %.2f, Peak = %.2f",name,MB(u.live),MB(u.peak));
+        }
+    s << "\n-----------------------------------------------------";
+    return s;
+    }
+
+MemUsage
+memoryUsage()
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    return M.total;
+    }
+
+MemUsage
+memoryUsage(MemKind k)
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    return M.kinds.at(k);
+    }
+
+MemUsage
+memoryUsage(std::string const& tag)
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    for(auto n : range(M.tagnames.size()))
+        {
+        if(tag == M.tagnames[n]) return M.tags[n];
+        }
+    return MemUsage{};
+    }
+
+void
+resetMemoryPeaks()
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    M.total.peak = M.total.live;
+    for(auto& u : M.kinds) u.peak = u.live;
+    for(auto& u : M.tags) u.peak = u.live;
+    }
+
+void
+setMemoryLimit(size_t bytes)
+    {
+    auto& M = detail::memTracker();
+        {
+        std::lock_guard<std::mutex> lock(M.mutex);
+        M.limit = bytes;
+        }
+    if(bytes > 0) setMemoryTracking(true);
+    }
+
+size_t
+memoryLimit()
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    return M.limit;
+    }
+
+bool
+memoryLimitExceeded()
+    {
+    auto& M = detail::memTracker();
+    std::lock_guard<std::mutex> lock(M.mutex);
+    return M.limit > 0 && M.total.live > M.limit;
+    }
+
+} //namespace itensor
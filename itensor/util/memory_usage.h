@@ -0,0 +1,155 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_MEMORY_USAGE_H
+#define __ITENSOR_MEMORY_USAGE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// Memory accounting for tensor storage
+//
+// When tracking is on, every buffer of tensor storage
+// (the data of Dense, QDense, Diag and QDiag, and the
+// scratch buffers used to permute tensors during
+// contraction) is recorded with its storage kind and
+// the tag of the innermost MemoryScope active when
+// it was allocated, for example
+//
+//    {
+//    auto ms = MemoryScope("environment");
+//    L = L*psi(b)*H(b)*dag(prime(psi(b)));
+//    }
+//
+// Live bytes and high-water marks ("peaks") are kept in
+// total, per storage kind and per tag. Buffers allocated
+// while tracking was off are not counted.
+//
+// Tracking is off by default; turn it on with
+// setMemoryTracking(true) or by setting a memory limit.
+//
+
+namespace itensor {
+
+enum MemKind
+    {
+    MemOther = 0,
+    MemDense,
+    MemQDense,
+    MemDiag,
+    MemQDiag,
+    MemScratch,
+    NMemKind
+    };
+
+const char*
+memKindName(MemKind k);
+
+namespace detail {
+extern std::atomic<bool> memtrack_on;
+extern std::atomic<long> memtrack_entries;
+void memTrackAlloc(void* p, size_t bytes, MemKind k);
+void memTrackFree(void* p);
+void memTrackSetKind(void const* p, MemKind k);
+int memEnterScope(const char* tag);
+void memLeaveScope(int prev);
+//Tag given to storage allocated by the calling thread
+int& memCurrentTag();
+} //namespace detail
+
+void
+setMemoryTracking(bool val);
+
+bool inline
+memoryTracking() { return detail::memtrack_on.load(std::memory_order_relaxed); }
+
+struct MemUsage
+    {
+    size_t live = 0;
+    size_t peak = 0;
+    };
+
+struct MemoryReport
+    {
+    MemUsage total;
+    std::array<MemUsage,NMemKind> kinds;
+    //Usage per MemoryScope tag; untagged
+    //storage has the empty tag ""
+    std::vector<std::pair<std::string,MemUsage>> tags;
+    };
+
+MemoryReport
+memoryReport();
+
+std::ostream&
+operator<<(std::ostream& s, MemoryReport const& R);
+
+//Total live and peak bytes
+MemUsage
+memoryUsage();
+
+MemUsage
+memoryUsage(MemKind k);
+
+MemUsage
+memoryUsage(std::string const& tag);
+
+//Set peaks (total, per kind and per tag) to the
+//current live bytes, for example to find the
+//high-water mark of a single sweep
+void
+resetMemoryPeaks();
+
+//Soft limit on the total live bytes of tensor storage,
+//checked by algorithms such as dmrg, which respond by
+//moving data to disk. Setting a limit (> 0) turns on
+//tracking; 0 means no limit (the default).
+void
+setMemoryLimit(size_t bytes);
+
+size_t
+memoryLimit();
+
+bool
+memoryLimitExceeded();
+
+//Tag storage allocated by this thread during the
+//lifetime of the scope. Tags must be string literals
+//(or otherwise outlive the program's use of them).
+struct MemoryScope
+    {
+    int prev = -1;
+
+    explicit
+    MemoryScope(const char* tag)
+        {
+        if(memoryTracking()) prev = detail::memEnterScope(tag);
+        }
+
+    ~MemoryScope() { if(prev >= 0) detail::memLeaveScope(prev); }
+
+    MemoryScope(MemoryScope const&) = delete;
+    MemoryScope& operator=(MemoryScope const&) = delete;
+    };
+
+} //namespace itensor
+
+#endif
@@ -16,6 +16,7 @@
 #ifndef __ITENSOR_PARALLEL_H
 #define __ITENSOR_PARALLEL_H
 #include "mpi.h"
+#include <mutex>
 #include <sstream>
 #include <vector>
 #include <type_traits>
@@ -193,7 +194,9 @@ class MailBox
 
     static int new_tag(Environment const& env, int other_node)
         {
+        static std::mutex mutex;
         static std::vector<int> tag(env.nnodes(),0);
+        std::lock_guard<std::mutex> lock(mutex);
         tag.at(other_node) += 3;
         return tag.at(other_node);
         }
@@ -0,0 +1,122 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_PARALLEL_FOR_H
+#define __ITENSOR_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+#include "itensor/tensor/lapack_wrap.h"
+#include "itensor/util/memory_usage.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/set_scoped.h"
+
+namespace itensor {
+
+//
+// Thread-local settings of the thread constructing
+// a ThreadContext: the gemmSinglePrecision() mode,
+// the MemoryScope tag and the profiler nesting depth.
+// run(f) calls f with these settings in effect on
+// the calling thread, such as a worker thread.
+//
+struct ThreadContext
+    {
+    bool single = gemmSinglePrecision();
+    int memtag = detail::memCurrentTag();
+    int depth = profiling() ? detail::profileDepth() : 0;
+
+    template<typename F>
+    void
+    run(F&& f) const
+        {
+        SET_SCOPED0(gemmSinglePrecision()) = single;
+        SET_SCOPED1(detail::memCurrentTag()) = memtag;
+        SET_SCOPED2(detail::profileBaseDepth()) = depth;
+        f();
+        }
+    };
+
+//Number of threads the hardware runs
+//concurrently (at least 1)
+int inline
+hardwareThreads() { return std::max(1,int(std::thread::hardware_concurrency())); }
+
+//
+// Call f(i) for i = 0,1,...,n-1 using up to nthread
+// threads, the calling thread being one of them.
+// Each thread takes the next unclaimed i, so calls
+// of uneven length are balanced. An exception thrown
+// by f is rethrown once all threads have finished.
+// Worker threads run with the ThreadContext of the
+// calling thread.
+//
+template<typename F>
+void
+parallelFor(size_t n,
+            int nthread,
+            F&& f)
+    {
+    auto nt = std::min(size_t(std::max(nthread,1)),n);
+    if(nt <= 1)
+        {
+        for(size_t i = 0; i < n; ++i) f(i);
+        return;
+        }
+    auto next = std::atomic<size_t>(0);
+    auto work = [&next,n,&f]
+        {
+        for(auto i = next++; i < n; i = next++) f(i);
+        };
+    auto ctx = ThreadContext{};
+    auto worker = [&work,&ctx] { ctx.run(work); };
+    auto futs = std::vector<std::future<void>>{};
+    for(size_t t = 1; t < nt; ++t)
+        {
+        futs.push_back(std::async(std::launch::async,worker));
+        }
+    work();
+    for(auto& fu : futs) fu.get();
+    }
+
+//
+// Sum the objects pointed to by x into *x[0] using
+// up to nthread threads, adding pairs in a tree
+// (x[0] += x[1], x[2] += x[3], ... then
+// x[0] += x[2], ...). The other objects are changed.
+//
+template<typename T>
+void
+parallelSum(std::vector<T*> const& x,
+            int nthread)
+    {
+    auto n = x.size();
+    for(size_t stride = 1; stride < n; stride *= 2)
+        {
+        auto npair = (n-stride+2*stride-1)/(2*stride);
+        parallelFor(npair,nthread,[&x,stride](size_t p)
+            {
+            auto i = 2*stride*p;
+            *x[i] += *x[i+stride];
+            });
+        }
+    }
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,249 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include "itensor/util/perfcounters.h"
+#include "itensor/util/iterate.h"
+#include "itensor/util/print.h"
+
+namespace itensor {
+
+const char*
+perfClassName(PerfClass c)
+    {
+    switch(c)
+        {
+        case PerfOther: return "Other";
+        case PerfContract: return "Contract";
+        case PerfGemm: return "Gemm";
+        case PerfPermute: return "Permute";
+        case PerfFactorize: return "Factorize";
+        default: return "Unknown";
+        }
+    }
+
+PerfCount& PerfCount::
+operator+=(PerfCount const& o)
+    {
+    flops += o.flops;
+    bytes_permuted += o.bytes_permuted;
+    bytes_allocated += o.bytes_allocated;
+    time += o.time;
+    calls += o.calls;
+    return *this;
+    }
+
+PerfCount& PerfCount::
+operator-=(PerfCount const& o)
+    {
+    flops -= o.flops;
+    bytes_permuted -= o.bytes_permuted;
+    bytes_allocated -= o.bytes_allocated;
+    time -= o.time;
+    calls -= o.calls;
+    return *this;
+    }
+
+double PerfCounters::
+flops() const
+    {
+    auto f = 0.;
+    for(auto& c : counts) f += c.flops;
+    return f;
+    }
+
+PerfCounters& PerfCounters::
+operator+=(PerfCounters const& o)
+    {
+    for(auto n : range(counts.size())) counts[n] += o.counts[n];
+    return *this;
+    }
+
+PerfCounters& PerfCounters::
+operator-=(PerfCounters const& o)
+    {
+    for(auto n : range(counts.size())) counts[n] -= o.counts[n];
+    return *this;
+    }
+
+std::ostream&
+operator<<(std::ostream& s, PerfCounters const& P)
+    {
+    s << "-----------------------------------------------------";
+    for(auto n : range(P.counts.size()))
+        {
+        auto& c = P.counts[n];
+        if(c.calls == 0 && c.flops == 0 && c.bytes_allocated == 0) continue;
+        s << format("\n%-10s Calls = %8d, Time = %.4f, GFlop = %.4f (%.3f GFlop/s), MB permuted = %.2f, MB allocated = %.2f",
+                    perfClassName(PerfClass(n)),c.calls,c.time,1E-9*c.flops,c.gflops(),
+                    1E-6*c.bytes_permuted,1E-6*c.bytes_allocated);
+        }
+    s << "\n-----------------------------------------------------";
+    return s;
+    }
+
+namespace detail {
+
+std::atomic<bool> perf_on(false);
+
+//Counters of a single thread. Only the owning thread
+//writes them, with relaxed atomic loads and stores, so
+//they can be read at any time without locking
+struct ThreadPerf
+    {
+    enum { Flops, BytesPermuted, BytesAllocated, Time, Calls, NField };
+    std::array<std::array<std::atomic<double>,NField>,NPerfClass> c;
+    //Accessed only by the owning thread
+    PerfClass current = PerfOther;
+    std::array<int,NPerfClass> depth = {};
+
+    ThreadPerf() { reset(); }
+
+    void
+    add(PerfClass cls, int field, double val)
+        {
+        auto& x = c[cls][field];
+        x.store(x.load(std::memory_order_relaxed)+val,std::memory_order_relaxed);
+        }
+
+    void
+    reset()
+        {
+        for(auto& cl : c) for(auto& x : cl) x.store(0.,std::memory_order_relaxed);
+        }
+
+    PerfCounters
+    counters() const
+        {
+        auto P = PerfCounters{};
+        for(auto n : range(c.size()))
+            {
+            auto& x = c[n];
+            auto& p = P.counts[n];
+            p.flops = x[Flops].load(std::memory_order_relaxed);
+            p.bytes_permuted = x[BytesPermuted].load(std::memory_order_relaxed);
+            p.bytes_allocated = x[BytesAllocated].load(std::memory_order_relaxed);
+            p.time = x[Time].load(std::memory_order_relaxed);
+            p.calls = long(x[Calls].load(std::memory_order_relaxed));
+            }
+        return P;
+        }
+    };
+
+struct PerfRegistry
+    {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadPerf>> threads;
+    };
+
+//Never destroyed, so that threads still running
+//during static destruction can count safely
+PerfRegistry&
+perfRegistry()
+    {
+    static auto* R = new PerfRegistry();
+    return *R;
+    }
+
+ThreadPerf&
+threadPerf()
+    {
+    thread_local std::shared_ptr<ThreadPerf> tp;
+    if(!tp)
+        {
+        tp = std::make_shared<ThreadPerf>();
+        auto& R = perfRegistry();
+        std::lock_guard<std::mutex> lock(R.mutex);
+        R.threads.push_back(tp);
+        }
+    return *tp;
+    }
+
+void
+perfAdd(PerfClass c, double flops, double bytes_permuted)
+    {
+    auto& T = threadPerf();
+    if(flops != 0) T.add(c,ThreadPerf::Flops,flops);
+    if(bytes_permuted != 0) T.add(c,ThreadPerf::BytesPermuted,bytes_permuted);
+    }
+
+void
+perfAllocated(double bytes)
+    {
+    auto& T = threadPerf();
+    T.add(T.current,ThreadPerf::BytesAllocated,bytes);
+    }
+
+PerfClass
+perfEnter(PerfClass c)
+    {
+    auto& T = threadPerf();
+    auto prev = T.current;
+    T.current = c;
+    T.depth[c] += 1;
+    return prev;
+    }
+
+void
+perfLeave(PerfClass c, PerfClass prev, double time)
+    {
+    auto& T = threadPerf();
+    T.current = prev;
+    T.depth[c] -= 1;
+    if(T.depth[c] == 0)
+        {
+        T.add(c,ThreadPerf::Time,time);
+        T.add(c,ThreadPerf::Calls,1);
+        }
+    }
+
+} //namespace detail
+
+void
+setPerfCounting(bool val)
+    {
+    detail::perfRegistry();
+    detail::perf_on.store(val);
+    }
+
+PerfCounters
+perfCounters()
+    {
+    auto P = PerfCounters{};
+    for(auto& T : perfCountersByThread()) P += T;
+    return P;
+    }
+
+std::vector<PerfCounters>
+perfCountersByThread()
+    {
+    auto& R = detail::perfRegistry();
+    std::lock_guard<std::mutex> lock(R.mutex);
+    auto res = std::vector<PerfCounters>{};
+    for(auto& T : R.threads) res.push_back(T->counters());
+    return res;
+    }
+
+void
+resetPerfCounters()
+    {
+    auto& R = detail::perfRegistry();
+    std::lock_guard<std::mutex> lock(R.mutex);
+    for(auto& T : R.threads) T->reset();
+    }
+
+} //namespace itensor
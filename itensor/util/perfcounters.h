@@ -0,0 +1,198 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_PERFCOUNTERS_H
+#define __ITENSOR_PERFCOUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <vector>
+
+//
+// Performance counters
+//
+// Count floating-point operations, bytes of data permuted
+// and bytes of tensor storage allocated, along with the
+// time spent and number of calls, for each class of
+// operation (contraction, matrix multiplication,
+// permutation and factorization).
+//
+// Counting is off by default; turn it on with
+// setPerfCounting(true). Each thread counts into its own
+// counters, which can be read summed over threads with
+// perfCounters() or separately with perfCountersByThread().
+//
+// Time and calls of an operation class are counted only for
+// the outermost scope of that class on a thread, so for
+// example a gemm called inside a factorization is counted
+// as PerfGemm as well as inside the time of PerfFactorize,
+// but a factorization calling another factorization is
+// counted once. Flops of factorizations are estimates based
+// on the standard operation counts of the LAPACK routines.
+//
+
+namespace itensor {
+
+enum PerfClass
+    {
+    PerfOther = 0,
+    PerfContract,
+    PerfGemm,
+    PerfPermute,
+    PerfFactorize,
+    NPerfClass
+    };
+
+const char*
+perfClassName(PerfClass c);
+
+struct PerfCount
+    {
+    double flops = 0;
+    double bytes_permuted = 0;
+    double bytes_allocated = 0;
+    double time = 0; //seconds
+    long calls = 0;
+
+    //Achieved GFLOP/s (0 if no time was counted)
+    double
+    gflops() const { return time > 0 ? 1E-9*flops/time : 0.; }
+
+    PerfCount&
+    operator+=(PerfCount const& o);
+
+    PerfCount&
+    operator-=(PerfCount const& o);
+    };
+
+struct PerfCounters
+    {
+    std::array<PerfCount,NPerfClass> counts;
+
+    PerfCount&
+    operator[](PerfClass c) { return counts[c]; }
+
+    PerfCount const&
+    operator[](PerfClass c) const { return counts[c]; }
+
+    //Sum over operation classes (times are not summed
+    //since scopes of different classes can be nested)
+    double
+    flops() const;
+
+    PerfCounters&
+    operator+=(PerfCounters const& o);
+
+    PerfCounters&
+    operator-=(PerfCounters const& o);
+    };
+
+PerfCounters inline
+operator-(PerfCounters A, PerfCounters const& B) { A -= B; return A; }
+
+PerfCounters inline
+operator+(PerfCounters A, PerfCounters const& B) { A += B; return A; }
+
+std::ostream&
+operator<<(std::ostream& s, PerfCounters const& P);
+
+namespace detail {
+extern std::atomic<bool> perf_on;
+void perfAdd(PerfClass c, double flops, double bytes_permuted);
+void perfAllocated(double bytes);
+PerfClass perfEnter(PerfClass c);
+void perfLeave(PerfClass c, PerfClass prev, double time);
+} //namespace detail
+
+void
+setPerfCounting(bool val);
+
+bool inline
+perfCounting() { return detail::perf_on.load(std::memory_order_relaxed); }
+
+//Counters summed over all threads
+PerfCounters
+perfCounters();
+
+//Counters of each thread that has counted an operation
+std::vector<PerfCounters>
+perfCountersByThread();
+
+//Set all counters to zero; should not be called while
+//other threads are counting
+void
+resetPerfCounters();
+
+void inline
+perfAddFlops(PerfClass c, double flops)
+    {
+    if(perfCounting()) detail::perfAdd(c,flops,0);
+    }
+
+void inline
+perfAddBytesPermuted(PerfClass c, double bytes)
+    {
+    if(perfCounting()) detail::perfAdd(c,0,bytes);
+    }
+
+//Counted for the class of the innermost PerfScope
+//of this thread (PerfOther if there is none)
+void inline
+perfAddBytesAllocated(double bytes)
+    {
+    if(perfCounting()) detail::perfAllocated(bytes);
+    }
+
+//Counts a call, its time and optionally its flops
+//for an operation class for the lifetime of the scope
+struct PerfScope
+    {
+    using clock_type = std::chrono::steady_clock;
+    PerfClass cls = PerfOther,
+              prev = PerfOther;
+    bool active = false;
+    clock_type::time_point start;
+
+    explicit
+    PerfScope(PerfClass c, double flops = 0)
+      : cls(c)
+        {
+        if(perfCounting())
+            {
+            active = true;
+            prev = detail::perfEnter(c);
+            if(flops != 0) detail::perfAdd(c,flops,0);
+            start = clock_type::now();
+            }
+        }
+
+    ~PerfScope()
+        {
+        if(active)
+            {
+            auto t = std::chrono::duration<double>(clock_type::now()-start).count();
+            detail::perfLeave(cls,prev,t);
+            }
+        }
+
+    PerfScope(PerfScope const&) = delete;
+    PerfScope& operator=(PerfScope const&) = delete;
+    };
+
+} //namespace itensor
+
+#endif
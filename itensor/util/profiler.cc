@@ -0,0 +1,319 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include "itensor/util/profiler.h"
+#include "itensor/util/error.h"
+#include "itensor/util/print.h"
+
+namespace itensor {
+
+namespace detail {
+
+std::atomic<bool> profiling_on(false);
+
+using profile_clock = std::chrono::steady_clock;
+
+std::atomic<size_t> profile_event_limit(100000);
+
+//Regions recorded by a single thread. Only the owning
+//thread appends to it, but the mutex is still taken
+//so that the buffer can be read or cleared while
+//other threads are running
+struct ProfileBuffer
+    {
+    std::mutex mutex;
+    int thread = 0;
+    //At most profile_event_limit regions
+    std::vector<ProfileEvent> events;
+    //Totals of all closed regions by name pointer
+    std::unordered_map<const char*,ProfileEntry> totals;
+    //Per open region: start time and time spent in nested regions
+    std::vector<std::pair<profile_clock::time_point,double>> open;
+    std::vector<const char*> names;
+    };
+
+struct ProfileRegistry
+    {
+    std::mutex mutex;
+    profile_clock::time_point epoch = profile_clock::now();
+    //Time of the last call to clearProfile
+    double cleared = 0;
+    std::vector<std::shared_ptr<ProfileBuffer>> buffers;
+    int nthread = 0;
+    };
+
+//Never destroyed, so that threads still running
+//during static destruction can record safely
+ProfileRegistry&
+profileRegistry()
+    {
+    static auto* R = new ProfileRegistry();
+    return *R;
+    }
+
+ProfileBuffer&
+threadBuffer()
+    {
+    thread_local std::shared_ptr<ProfileBuffer> buf;
+    if(!buf)
+        {
+        buf = std::make_shared<ProfileBuffer>();
+        auto& R = profileRegistry();
+        std::lock_guard<std::mutex> lock(R.mutex);
+        buf->thread = R.nthread++;
+        R.buffers.push_back(buf);
+        }
+    return *buf;
+    }
+
+double
+sinceEpoch(profile_clock::time_point t)
+    {
+    return std::chrono::duration<double>(t-profileRegistry().epoch).count();
+    }
+
+int&
+profileBaseDepth()
+    {
+    thread_local int base = 0;
+    return base;
+    }
+
+int
+profileDepth() { return profileBaseDepth()+threadBuffer().open.size(); }
+
+void
+profileBegin(const char* name)
+    {
+    auto& B = threadBuffer();
+    B.names.push_back(name);
+    B.open.emplace_back(profile_clock::now(),0.);
+    }
+
+void
+profileEnd()
+    {
+    auto end = profile_clock::now();
+    auto& B = threadBuffer();
+    if(B.open.empty()) return;
+    auto [start,nested] = B.open.back();
+    B.open.pop_back();
+    auto ev = ProfileEvent{};
+    ev.name = B.names.back();
+    B.names.pop_back();
+    ev.start = sinceEpoch(start);
+    ev.time = std::chrono::duration<double>(end-start).count();
+    ev.self = ev.time-nested;
+    ev.depth = profileBaseDepth()+B.open.size();
+    ev.thread = B.thread;
+    if(!B.open.empty()) B.open.back().second += ev.time;
+    std::lock_guard<std::mutex> lock(B.mutex);
+    auto& T = B.totals[ev.name];
+    T.count += 1;
+    T.time += ev.time;
+    T.self += ev.self;
+    if(B.events.size() < profile_event_limit.load(std::memory_order_relaxed))
+        {
+        B.events.push_back(ev);
+        }
+    }
+
+void
+jsonEscaped(std::ostream& s, const char* str)
+    {
+    for(auto p = str; *p != '\0'; ++p)
+        {
+        auto c = *p;
+        if(c == '"' || c == '\\') s << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20) s << ' ';
+        else s << c;
+        }
+    }
+
+} //namespace detail
+
+void
+setProfiling(bool val)
+    {
+    detail::profileRegistry();
+    detail::profiling_on.store(val);
+    }
+
+double
+profileNow()
+    {
+    return detail::sinceEpoch(detail::profile_clock::now());
+    }
+
+void
+clearProfile()
+    {
+    auto& R = detail::profileRegistry();
+    std::lock_guard<std::mutex> lock(R.mutex);
+    for(auto& B : R.buffers)
+        {
+        std::lock_guard<std::mutex> block(B->mutex);
+        B->events.clear();
+        B->totals.clear();
+        }
+    R.cleared = profileNow();
+    //Drop buffers of threads that have exited
+    auto exited = [](auto& B) { return B.use_count() == 1; };
+    R.buffers.erase(std::remove_if(R.buffers.begin(),R.buffers.end(),exited),
+                    R.buffers.end());
+    }
+
+void
+setProfileEventLimit(size_t n)
+    {
+    detail::profile_event_limit.store(n);
+    }
+
+size_t
+profileEventLimit()
+    {
+    return detail::profile_event_limit.load();
+    }
+
+std::vector<ProfileEvent>
+profileEvents(double since)
+    {
+    auto res = std::vector<ProfileEvent>{};
+    auto& R = detail::profileRegistry();
+    std::lock_guard<std::mutex> lock(R.mutex);
+    for(auto& B : R.buffers)
+        {
+        std::lock_guard<std::mutex> block(B->mutex);
+        for(auto& ev : B->events)
+            {
+            if(ev.start >= since) res.push_back(ev);
+            }
+        }
+    std::sort(res.begin(),res.end(),
+              [](auto const& a, auto const& b)
+              {
+              if(a.thread != b.thread) return a.thread < b.thread;
+              return a.start < b.start;
+              });
+    return res;
+    }
+
+ProfileSummary
+profileSummary()
+    {
+    auto P = ProfileSummary{};
+    auto& R = detail::profileRegistry();
+    auto pos = std::unordered_map<std::string,size_t>{};
+        {
+        std::lock_guard<std::mutex> lock(R.mutex);
+        P.at = profileNow();
+        P.wall = P.at-R.cleared;
+        for(auto& B : R.buffers)
+            {
+            std::lock_guard<std::mutex> block(B->mutex);
+            for(auto& [name,T] : B->totals)
+                {
+                auto it = pos.find(name);
+                if(it == pos.end())
+                    {
+                    it = pos.emplace(name,P.entries.size()).first;
+                    P.entries.emplace_back();
+                    P.entries.back().name = name;
+                    }
+                auto& E = P.entries[it->second];
+                E.count += T.count;
+                E.time += T.time;
+                E.self += T.self;
+                }
+            }
+        }
+    std::sort(P.entries.begin(),P.entries.end(),
+              [](auto const& a, auto const& b) { return a.time > b.time; });
+    return P;
+    }
+
+ProfileSummary
+profileSummary(ProfileSummary const& since)
+    {
+    auto P = profileSummary();
+    P.wall = P.at-since.at;
+    for(auto& E : P.entries)
+        {
+        for(auto& S : since.entries)
+            {
+            if(S.name != E.name) continue;
+            E.count -= S.count;
+            E.time -= S.time;
+            E.self -= S.self;
+            break;
+            }
+        }
+    auto none = [](auto const& E) { return E.count <= 0; };
+    P.entries.erase(std::remove_if(P.entries.begin(),P.entries.end(),none),
+                    P.entries.end());
+    std::sort(P.entries.begin(),P.entries.end(),
+              [](auto const& a, auto const& b) { return a.time > b.time; });
+    return P;
+    }
+
+std::ostream&
+operator<<(std::ostream& s, ProfileSummary const& P)
+    {
+    s << "-----------------------------------------------------\n";
+    s << format("Profile:                 Wall Time = %.4f",P.wall);
+    for(auto& E : P.entries)
+        {
+        auto pct = P.wall > 0 ? 100*(E.time/P.wall) : 0.;
+        s << format("\n%-28s Count = %7d, Total = %.4f [%5.1f%%], Self = %.4f",
+                    E.name,E.count,E.time,pct,E.self);
+        }
+    s << "\n-----------------------------------------------------";
+    return s;
+    }
+
+void
+writeChromeTrace(std::ostream& s)
+    {
+    auto events = profileEvents();
+    s << "{\"traceEvents\":[";
+    auto first = true;
+    for(auto& ev : events)
+        {
+        if(!first) s << ",";
+        first = false;
+        s << "\n{\"name\":\"";
+        detail::jsonEscaped(s,ev.name);
+        s << format("\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}",
+                    1E6*ev.start,1E6*ev.time,ev.thread);
+        }
+    s << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+void
+writeChromeTrace(std::string const& fname)
+    {
+    auto f = std::ofstream(fname);
+    if(!f.good()) Error("Could not open file \"" + fname + "\" for writing");
+    writeChromeTrace(f);
+    }
+
+} //namespace itensor
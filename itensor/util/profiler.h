@@ -0,0 +1,185 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_PROFILER_H
+#define __ITENSOR_PROFILER_H
+
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+//
+// Hierarchical profiler with named regions
+//
+// A region is timed from the point where PROFILE_REGION
+// appears to the end of the enclosing scope:
+//
+//    {
+//    PROFILE_REGION("dmrg.position");
+//    PH.position(b,psi);
+//    }
+//
+// Regions nest, and each thread records into its own buffer.
+// Profiling is off by default; when off, a region costs a
+// single atomic load. Turn it on with setProfiling(true),
+// then export the recorded regions with writeChromeTrace
+// (viewable in chrome://tracing or Perfetto) or print
+// a flat summary with profileSummary.
+//
+// A thread keeps at most profileEventLimit() regions for
+// profileEvents and writeChromeTrace; later ones are only
+// added to the per-name totals, which are kept for every
+// region so that summaries of long runs stay complete.
+//
+// Region names must be string literals (or otherwise
+// outlive the profiler) since only the pointer is stored.
+//
+// Defining ITENSOR_NO_PROFILE compiles all regions out.
+//
+
+namespace itensor {
+
+namespace detail {
+extern std::atomic<bool> profiling_on;
+void profileBegin(const char* name);
+void profileEnd();
+//Depth added to the nesting depth of regions
+//recorded by the calling thread
+int& profileBaseDepth();
+//Nesting depth of the innermost open region of
+//the calling thread (0 if none)
+int profileDepth();
+} //namespace detail
+
+void
+setProfiling(bool val);
+
+bool inline
+profiling() { return detail::profiling_on.load(std::memory_order_relaxed); }
+
+//Seconds elapsed since the profiler's reference time
+double
+profileNow();
+
+//Discard all recorded regions and totals (of all threads)
+void
+clearProfile();
+
+//Most regions each thread keeps for profileEvents
+//and writeChromeTrace (default 100000)
+void
+setProfileEventLimit(size_t n);
+
+size_t
+profileEventLimit();
+
+struct ProfileEvent
+    {
+    const char* name = nullptr;
+    double start = 0; //seconds since reference time
+    double time = 0;  //total time spent in region
+    double self = 0;  //time not spent in nested regions
+    int depth = 0;    //nesting depth, 0 for outermost
+    int thread = 0;   //profiler thread number, 0 for first thread
+    };
+
+//All recorded regions that started at or after time since
+std::vector<ProfileEvent>
+profileEvents(double since = 0);
+
+struct ProfileEntry
+    {
+    std::string name;
+    long count = 0;
+    double time = 0;
+    double self = 0;
+    };
+
+struct ProfileSummary
+    {
+    //Time (see profileNow) the summary was taken
+    double at = 0;
+    //Time covered by the summary
+    double wall = 0;
+    //Entries sorted by decreasing total time
+    std::vector<ProfileEntry> entries;
+    };
+
+//Totals of the regions closed since the last call to
+//clearProfile, summed over threads and grouped by name
+ProfileSummary
+profileSummary();
+
+//Totals of the regions closed after the summary since
+//was taken, for example
+//
+//    auto start = profileSummary();
+//    ...
+//    println(profileSummary(start));
+//
+ProfileSummary
+profileSummary(ProfileSummary const& since);
+
+std::ostream&
+operator<<(std::ostream& s, ProfileSummary const& P);
+
+//Write recorded regions in the Chrome trace-event JSON format
+void
+writeChromeTrace(std::ostream& s);
+
+void
+writeChromeTrace(std::string const& fname);
+
+struct ProfileRegion
+    {
+    bool active = false;
+
+    explicit
+    ProfileRegion(const char* name)
+        {
+        if(profiling())
+            {
+            active = true;
+            detail::profileBegin(name);
+            }
+        }
+
+    ~ProfileRegion() { end(); }
+
+    //Close the region before the end of its scope
+    void
+    end()
+        {
+        if(active) detail::profileEnd();
+        active = false;
+        }
+
+    ProfileRegion(ProfileRegion const&) = delete;
+    ProfileRegion& operator=(ProfileRegion const&) = delete;
+    };
+
+} //namespace itensor
+
+#define ITENSOR_PROFILE_CAT2(a,b) a##b
+#define ITENSOR_PROFILE_CAT(a,b) ITENSOR_PROFILE_CAT2(a,b)
+
+#ifdef ITENSOR_NO_PROFILE
+#define PROFILE_REGION(NAME)
+#else
+#define PROFILE_REGION(NAME) itensor::ProfileRegion ITENSOR_PROFILE_CAT(profile_region_,__LINE__)(NAME);
+#endif
+
+#endif
@@ -0,0 +1,150 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <future>
+#include <vector>
+#include <unistd.h>
+#include "itensor/util/random.h"
+
+namespace itensor {
+
+namespace detail {
+
+std::atomic<uint64_t> random_seed(uint64_t(std::time(NULL)+getpid()));
+
+//Incremented by setRandomSeed, so threads know
+//to restart their streams
+std::atomic<uint64_t> random_generation(0);
+
+//Next thread stream number
+std::atomic<uint64_t> random_next_thread(0);
+
+//Thread streams are numbered from 2^63 so they
+//do not overlap task streams
+const uint64_t thread_stream_offset = uint64_t(1) << 63;
+
+struct ThreadStream
+    {
+    uint64_t generation = ~uint64_t(0);
+    RandomStream stream;
+    };
+
+ThreadStream&
+threadStream()
+    {
+    thread_local auto T = ThreadStream{};
+    return T;
+    }
+
+} //namespace detail
+
+void
+setRandomSeed(uint64_t seed)
+    {
+    detail::random_seed.store(seed);
+    detail::random_next_thread.store(1);
+    auto gen = detail::random_generation.fetch_add(1)+1;
+    auto& T = detail::threadStream();
+    T.generation = gen;
+    T.stream = RandomStream(seed,detail::thread_stream_offset);
+    }
+
+uint64_t
+randomSeed() { return detail::random_seed.load(); }
+
+RandomStream&
+threadRandomStream()
+    {
+    auto& T = detail::threadStream();
+    auto gen = detail::random_generation.load(std::memory_order_acquire);
+    if(T.generation != gen)
+        {
+        T.generation = gen;
+        auto n = detail::random_next_thread.fetch_add(1);
+        T.stream = RandomStream(randomSeed(),detail::thread_stream_offset+n);
+        }
+    return T.stream;
+    }
+
+RandomStream
+taskRandomStream(uint64_t n)
+    {
+    return RandomStream(randomSeed(),n);
+    }
+
+namespace detail {
+
+//Call fillChunk(b,e) for consecutive ranges [b,e)
+//covering [0,n), each on its own thread
+template<typename F>
+void
+parallelRandomFill(size_t n,
+                   int nthread,
+                   F&& fillChunk)
+    {
+    //Below this many numbers per thread,
+    //starting threads is not worth it
+    const size_t min_chunk = 1ul << 15;
+    auto nchunk = std::max(1ul,std::min(size_t(std::max(nthread,1)),n/min_chunk));
+    if(nchunk == 1)
+        {
+        fillChunk(0,n);
+        return;
+        }
+    auto chunk = (n+nchunk-1)/nchunk;
+    auto futs = std::vector<std::future<void>>{};
+    for(size_t b = chunk; b < n; b += chunk)
+        {
+        auto e = std::min(n,b+chunk);
+        futs.push_back(std::async(std::launch::async,[&fillChunk,b,e] { fillChunk(b,e); }));
+        }
+    fillChunk(0,std::min(n,chunk));
+    for(auto& f : futs) f.get();
+    }
+
+} //namespace detail
+
+void
+randomFill(Real* p, size_t n, uint64_t stream, int nthread)
+    {
+    auto seed = randomSeed();
+    detail::parallelRandomFill(n,nthread,[p,seed,stream](size_t b, size_t e)
+        {
+        auto S = RandomStream(seed,stream);
+        S.seek(b);
+        for(auto i = b; i < e; ++i) p[i] = S.uniform();
+        });
+    }
+
+void
+randomFill(Cplx* p, size_t n, uint64_t stream, int nthread)
+    {
+    auto seed = randomSeed();
+    detail::parallelRandomFill(n,nthread,[p,seed,stream](size_t b, size_t e)
+        {
+        auto S = RandomStream(seed,stream);
+        S.seek(2*b);
+        for(auto i = b; i < e; ++i)
+            {
+            auto re = S.uniform();
+            p[i] = Cplx(re,S.uniform());
+            }
+        });
+    }
+
+} //namespace itensor
@@ -0,0 +1,171 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_RANDOM_H
+#define __ITENSOR_RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include "itensor/types.h"
+
+//
+// Counter-based random numbers
+//
+// Random numbers are computed by the Philox4x32-10
+// function (Salmon et al., "Parallel Random Numbers:
+// As Easy as 1, 2, 3", SC 2011), which maps a key and
+// a counter to four 32-bit random numbers. The key is
+// the global seed, and the counter holds a stream number
+// and a position in the stream, so any number of any
+// stream can be computed directly, by any thread.
+//
+// o The calling thread draws from its own stream,
+//   threadRandomStream(); Global::random() and
+//   randomReal() use this stream. The first thread to
+//   use random numbers (or the thread which last called
+//   seedRNG) gets stream 0, so single-threaded code
+//   gives the same numbers for the same seed.
+// o For reproducible results in threaded code, give
+//   each task its own stream: taskRandomStream(n).
+// o randomFill fills a buffer using several threads;
+//   element i is the number at position i of the given
+//   stream, whatever the number of threads.
+//
+
+namespace itensor {
+
+using Philox4x32Counter = std::array<uint32_t,4>;
+using Philox4x32Key = std::array<uint32_t,2>;
+
+Philox4x32Counter inline
+philox4x32(Philox4x32Counter c, Philox4x32Key k)
+    {
+    for(int r = 0; r < 10; ++r)
+        {
+        if(r > 0)
+            {
+            k[0] += 0x9E3779B9u;
+            k[1] += 0xBB67AE85u;
+            }
+        auto p0 = uint64_t(0xD2511F53u)*c[0];
+        auto p1 = uint64_t(0xCD9E8D57u)*c[2];
+        c = {uint32_t(p1 >> 32)^c[1]^k[0],uint32_t(p1),
+             uint32_t(p0 >> 32)^c[3]^k[1],uint32_t(p0)};
+        }
+    return c;
+    }
+
+//Uniform number in [0,1) from 64 random bits
+Real inline
+uniformFromBits(uint64_t x) { return Real(x >> 11)*0x1.0p-53; }
+
+//
+// Sequence of random numbers at positions 0,1,2,...
+// of stream "stream" for the given seed. Each Real uses
+// 64 random bits (half of one Philox block).
+//
+class RandomStream
+    {
+    Philox4x32Key key_ = {{0,0}};
+    uint64_t stream_ = 0;
+    uint64_t pos_ = 0;   //position of next 64-bit draw
+    Philox4x32Counter block_ = {{0,0,0,0}};
+    public:
+
+    RandomStream() { }
+
+    RandomStream(uint64_t seed, uint64_t stream)
+      : key_({{uint32_t(seed),uint32_t(seed >> 32)}}),
+        stream_(stream)
+        { }
+
+    uint64_t
+    stream() const { return stream_; }
+
+    //Number of 64-bit values drawn so far
+    uint64_t
+    position() const { return pos_; }
+
+    //Continue from position n
+    void
+    seek(uint64_t n) 
+        { 
+        pos_ = n; 
+        if(pos_%2 == 1) loadBlock();
+        }
+
+    uint64_t
+    next64()
+        {
+        if(pos_%2 == 0) loadBlock();
+        auto w = 2*(pos_%2);
+        ++pos_;
+        return (uint64_t(block_[w+1]) << 32) | block_[w];
+        }
+
+    //Uniform random number in [0,1)
+    Real
+    uniform() { return uniformFromBits(next64()); }
+
+    Real
+    operator()() { return uniform(); }
+
+    private:
+
+    //Compute the block holding position pos_
+    void
+    loadBlock()
+        {
+        auto b = pos_/2;
+        block_ = philox4x32({{uint32_t(b),uint32_t(b >> 32),
+                              uint32_t(stream_),uint32_t(stream_ >> 32)}},key_);
+        }
+    };
+
+//Set the global seed; thread streams restart
+//(the calling thread gets stream 0)
+void
+setRandomSeed(uint64_t seed);
+
+uint64_t
+randomSeed();
+
+//Stream of the calling thread
+RandomStream&
+threadRandomStream();
+
+//Stream for task number n (independent of the
+//thread streams and of which thread runs the task)
+RandomStream
+taskRandomStream(uint64_t n);
+
+//Uniform random number in [0,1) from the
+//stream of the calling thread
+Real inline
+randomReal() { return threadRandomStream().uniform(); }
+
+//Set p[i] to the number at position i of stream
+//"stream" (for Cplx, real and imaginary parts are at
+//positions 2i and 2i+1), using up to nthread threads
+//for large n
+void
+randomFill(Real* p, size_t n, uint64_t stream, int nthread = 1);
+
+void
+randomFill(Cplx* p, size_t n, uint64_t stream, int nthread = 1);
+
+} //namespace itensor
+
+#endif
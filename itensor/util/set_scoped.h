@@ -16,6 +16,8 @@
 #ifndef __ITENSOR_SET_SCOPED_H
 #define __ITENSOR_SET_SCOPED_H
 
+#include <atomic>
+
 namespace itensor {
 
 //
@@ -41,11 +43,20 @@ namespace itensor {
 
 namespace detail {
 
+//Type of the saved value (for an atomic
+//variable, the type it holds)
+template<typename T>
+struct ScopedValue { using type = T; };
+
+template<typename T>
+struct ScopedValue<std::atomic<T>> { using type = T; };
+
 template<typename T>
 class SetScoped
     {
+    using value_type = typename ScopedValue<T>::type;
     T* pi;
-    T oval = 0;
+    value_type oval = value_type{};
     public:
     explicit
     SetScoped(T& i) : pi(&i), oval(i) { }
@@ -61,7 +72,7 @@ class SetScoped
         oval(other.oval)
         {
         other.pi = nullptr;
-        other.oval = 0;
+        other.oval = value_type{};
         }
 
     SetScoped&
@@ -70,12 +81,12 @@ class SetScoped
         pi = other.pi;
         oval = other.oval;
         other.pi = nullptr;
-        other.oval = 0;
+        other.oval = value_type{};
         return *this;
         }
 
     void
-    setNewVal(const T& nval)
+    setNewVal(value_type const& nval)
         {
         *pi = nval;
         }
@@ -90,11 +101,11 @@ struct MakeSetScoped
     MakeSetScoped(T& i) : pi(&i) { }
 
     SetScoped<T>
-    operator=(T const& nval) 
+    operator=(typename ScopedValue<T>::type const& nval) 
         { 
         SetScoped<T> sv(*pi);
         sv.setNewVal(nval);
-        return std::move(sv);
+        return sv;
         }
     };
 } //namespace detail
@@ -0,0 +1,242 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#include "itensor/util/storage_alloc.h"
+#include "itensor/util/perfcounters.h"
+
+namespace itensor {
+
+namespace detail {
+
+//Buffers smaller than this are not cached
+size_t constexpr MinCachedSize = 4096;
+
+//Round up to a size class: for sizes in (p,2p]
+//classes are spaced by p/4, wasting at most 25%
+size_t
+sizeClass(size_t bytes)
+    {
+    if(bytes < MinCachedSize)
+        {
+        return ((bytes+StorageAlignment-1)/StorageAlignment)*StorageAlignment;
+        }
+    size_t p = MinCachedSize/2;
+    while(2*p < bytes) p *= 2;
+    auto step = p/4;
+    return ((bytes+step-1)/step)*step;
+    }
+
+//The cache is split into shards, each with its own
+//lock; a thread uses a single shard, so threads
+//allocating at the same time rarely wait for each other
+size_t constexpr NCacheShard = 16;
+
+struct alignas(64) CacheShard
+    {
+    std::mutex mutex;
+    std::unordered_map<size_t,std::vector<void*>> free;
+    };
+
+struct StorageCache
+    {
+    std::array<CacheShard,NCacheShard> shards;
+    std::atomic<size_t> cached = 0;
+    std::atomic<size_t> limit = 0;
+    std::atomic<bool> huge = false;
+    };
+
+//Never destroyed, so that storage freed during
+//static destruction can still be returned
+StorageCache&
+storageCache()
+    {
+    static auto* c = new StorageCache();
+    return *c;
+    }
+
+CacheShard&
+threadShard(StorageCache & c)
+    {
+    thread_local auto n = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NCacheShard;
+    return c.shards[n];
+    }
+
+void*
+systemAllocate(size_t size, bool huge)
+    {
+    auto align = StorageAlignment;
+    if(huge && size >= HugePageSize)
+        {
+        align = HugePageSize;
+        size = ((size+align-1)/align)*align;
+        }
+    auto p = std::aligned_alloc(align,size);
+    if(!p) throw std::bad_alloc();
+#ifdef __linux__
+    if(align == HugePageSize) madvise(p,size,MADV_HUGEPAGE);
+#endif
+    return p;
+    }
+
+void
+systemDeallocate(void* p) noexcept
+    {
+    std::free(p);
+    }
+
+void*
+cacheAllocate(size_t bytes)
+    {
+    auto& c = storageCache();
+    auto size = sizeClass(bytes);
+    //With the cache empty (always so when it is off)
+    //no lock is taken
+    if(size >= MinCachedSize && c.cached.load(std::memory_order_relaxed) > 0)
+        {
+        auto& s = threadShard(c);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.free.find(size);
+        if(it != s.free.end() && !it->second.empty())
+            {
+            auto p = it->second.back();
+            it->second.pop_back();
+            c.cached -= size;
+            return p;
+            }
+        }
+    return systemAllocate(size,c.huge.load(std::memory_order_relaxed));
+    }
+
+void
+cacheDeallocate(void* p, size_t bytes)
+    {
+    auto& c = storageCache();
+    auto size = sizeClass(bytes);
+    if(size >= MinCachedSize && c.limit.load(std::memory_order_relaxed) > 0)
+        {
+        if(c.cached.fetch_add(size)+size <= c.limit.load())
+            {
+            auto& s = threadShard(c);
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.free[size].push_back(p);
+            return;
+            }
+        c.cached -= size;
+        }
+    systemDeallocate(p);
+    }
+
+StorageAllocator&
+storageAllocator()
+    {
+    static auto A = StorageAllocator{cacheAllocate,cacheDeallocate};
+    return A;
+    }
+
+//Free cached buffers until at most maxsize bytes remain
+void
+trimCache(StorageCache & c, size_t maxsize)
+    {
+    for(auto& s : c.shards)
+        {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for(auto& [size,ptrs] : s.free)
+            {
+            while(c.cached > maxsize && !ptrs.empty())
+                {
+                systemDeallocate(ptrs.back());
+                ptrs.pop_back();
+                c.cached -= size;
+                }
+            }
+        }
+    }
+
+} //namespace detail
+
+void*
+allocateStorage(size_t bytes)
+    {
+    perfAddBytesAllocated(bytes);
+    return detail::storageAllocator().allocate(bytes);
+    }
+
+void
+deallocateStorage(void* p, size_t bytes) noexcept
+    {
+    detail::storageAllocator().deallocate(p,bytes);
+    }
+
+void
+setStorageCacheLimit(size_t bytes)
+    {
+    auto& c = detail::storageCache();
+    c.limit = bytes;
+    detail::trimCache(c,bytes);
+    }
+
+size_t
+storageCacheLimit()
+    {
+    return detail::storageCache().limit;
+    }
+
+size_t
+storageCacheSize()
+    {
+    return detail::storageCache().cached;
+    }
+
+void
+clearStorageCache()
+    {
+    detail::trimCache(detail::storageCache(),0);
+    }
+
+void
+setStorageHugePages(bool val)
+    {
+    auto& c = detail::storageCache();
+    c.huge = val;
+    //Release cached buffers allocated 
+    //with the previous setting
+    detail::trimCache(c,0);
+    }
+
+bool
+storageHugePages()
+    {
+    return detail::storageCache().huge;
+    }
+
+void
+setStorageAllocator(StorageAllocator const& A)
+    {
+    detail::storageAllocator() = A;
+    }
+
+} //namespace itensor
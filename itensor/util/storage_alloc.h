@@ -0,0 +1,98 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_STORAGE_ALLOC_H
+#define __ITENSOR_STORAGE_ALLOC_H
+
+#include <cstddef>
+
+namespace itensor {
+
+//
+// Memory for tensor storage (the data of Dense and QDense,
+// through uninitialized_allocator / vector_no_init)
+// is obtained from allocateStorage and returned to
+// deallocateStorage.
+//
+// The default allocator returns memory aligned to 
+// StorageAlignment bytes. Optionally (see
+// setStorageCacheLimit) it keeps freed buffers in a
+// cache, sorted into size classes, so that the many 
+// same-sized temporaries of a DMRG sweep reuse memory
+// instead of going back to the system each time.
+//
+
+size_t constexpr StorageAlignment = 64;
+
+void*
+allocateStorage(size_t bytes);
+
+void
+deallocateStorage(void* p, size_t bytes) noexcept;
+
+//
+// Settings of the default allocator
+//
+
+//Maximum number of bytes of freed buffers kept in
+//the cache. The default 0 disables caching, so freed
+//storage goes back to the system at once. Cached
+//buffers are held by the process but are not counted
+//by memoryUsage() or setMemoryLimit; see storageCacheSize.
+void
+setStorageCacheLimit(size_t bytes);
+
+size_t
+storageCacheLimit();
+
+//Number of bytes currently held in the cache
+size_t
+storageCacheSize();
+
+//Return all cached buffers to the system
+void
+clearStorageCache();
+
+//If true, allocations of at least HugePageSize bytes
+//are aligned to HugePageSize and (on Linux) marked 
+//with madvise(MADV_HUGEPAGE) to request transparent
+//huge pages (default false)
+void
+setStorageHugePages(bool val);
+
+bool
+storageHugePages();
+
+size_t constexpr HugePageSize = 2*1024*1024;
+
+//
+// Replace the default allocator, for example to
+// use a custom memory pool. Must be called before
+// any tensor storage is allocated, since memory is
+// returned to whichever allocator is set at the time
+// it is freed.
+//
+struct StorageAllocator
+    {
+    void* (*allocate)(size_t bytes) = nullptr;
+    void (*deallocate)(void* p, size_t bytes) = nullptr;
+    };
+
+void
+setStorageAllocator(StorageAllocator const& A);
+
+} //namespace itensor
+
+#endif
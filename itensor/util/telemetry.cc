@@ -0,0 +1,316 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "itensor/util/telemetry.h"
+#include "itensor/util/error.h"
+#include "itensor/util/iterate.h"
+
+namespace itensor {
+
+TelemetryRecord& TelemetryRecord::
+add(std::string key, double val)
+    {
+    char buf[32];
+    if(std::isfinite(val)) std::snprintf(buf,sizeof(buf),"%.15g",val);
+    else std::snprintf(buf,sizeof(buf),"nan");
+    fields_.push_back(Field{std::move(key),buf,false});
+    return *this;
+    }
+
+TelemetryRecord& TelemetryRecord::
+add(std::string key, long val)
+    {
+    fields_.push_back(Field{std::move(key),std::to_string(val),false});
+    return *this;
+    }
+
+TelemetryRecord& TelemetryRecord::
+add(std::string key, bool val)
+    {
+    fields_.push_back(Field{std::move(key),val ? "true" : "false",false});
+    return *this;
+    }
+
+TelemetryRecord& TelemetryRecord::
+add(std::string key, std::string val)
+    {
+    fields_.push_back(Field{std::move(key),std::move(val),true});
+    return *this;
+    }
+
+namespace detail {
+
+std::atomic<bool> telemetry_on(false);
+
+std::string
+jsonString(std::string const& s)
+    {
+    auto res = std::string("\"");
+    for(auto c : s)
+        {
+        if(c == '"' || c == '\\') { res += '\\'; res += c; }
+        else if(c == '\n') res += "\\n";
+        else if(c == '\t') res += "\\t";
+        else if(static_cast<unsigned char>(c) < 0x20)
+            {
+            char buf[8];
+            std::snprintf(buf,sizeof(buf),"\\u%04x",int(c));
+            res += buf;
+            }
+        else res += c;
+        }
+    res += '"';
+    return res;
+    }
+
+std::string
+csvString(std::string const& s)
+    {
+    if(s.find_first_of(",\"\n") == std::string::npos) return s;
+    auto res = std::string("\"");
+    for(auto c : s)
+        {
+        if(c == '"') res += '"';
+        res += c;
+        }
+    res += '"';
+    return res;
+    }
+
+class TelemetryWriter
+    {
+    public:
+
+    enum Format { JSONL, CSV };
+
+    private:
+
+    std::string fname_;
+    Format format_ = JSONL;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable written_cv_;
+    std::deque<TelemetryRecord> queue_;
+    size_t nemitted_ = 0;
+    size_t nwritten_ = 0;
+    bool stop_ = false;
+
+    //Accessed only by the writer thread
+    std::ofstream jsonl_;
+    struct CSVFile
+        {
+        std::ofstream s;
+        std::vector<std::string> header;
+        };
+    std::map<std::string,CSVFile> csv_;
+
+    std::thread thread_;
+
+    public:
+
+    TelemetryWriter(std::string fname, Format format)
+      : fname_(std::move(fname)),
+        format_(format)
+        {
+        if(format_ == JSONL)
+            {
+            jsonl_.open(fname_);
+            if(!jsonl_.is_open()) Error("Could not open telemetry file " + fname_);
+            }
+        thread_ = std::thread([this] { run(); });
+        }
+
+    ~TelemetryWriter()
+        {
+            {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            }
+        cv_.notify_one();
+        thread_.join();
+        }
+
+    void
+    emit(TelemetryRecord&& r)
+        {
+            {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(r));
+            ++nemitted_;
+            }
+        cv_.notify_one();
+        }
+
+    void
+    flush()
+        {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto target = nemitted_;
+        written_cv_.wait(lock,[&] { return nwritten_ >= target; });
+        }
+
+    private:
+
+    void
+    run()
+        {
+        auto batch = std::deque<TelemetryRecord>{};
+        while(true)
+            {
+                {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock,[this] { return stop_ || !queue_.empty(); });
+                if(queue_.empty() && stop_) break;
+                std::swap(batch,queue_);
+                }
+            for(auto& r : batch) write(r);
+            if(format_ == JSONL) jsonl_.flush();
+            else for(auto& f : csv_) f.second.s.flush();
+                {
+                std::lock_guard<std::mutex> lock(mutex_);
+                nwritten_ += batch.size();
+                }
+            batch.clear();
+            written_cv_.notify_all();
+            }
+        }
+
+    void
+    write(TelemetryRecord const& r)
+        {
+        if(format_ == JSONL)
+            {
+            jsonl_ << "{\"record\":" << jsonString(r.type());
+            for(auto& f : r.fields())
+                {
+                jsonl_ << "," << jsonString(f.key) << ":";
+                if(f.is_string) jsonl_ << jsonString(f.val);
+                else if(f.val == "nan") jsonl_ << "null";
+                else jsonl_ << f.val;
+                }
+            jsonl_ << "}\n";
+            return;
+            }
+
+        auto it = csv_.find(r.type());
+        if(it == csv_.end())
+            {
+            auto& F = csv_[r.type()];
+            auto dot = fname_.rfind('.');
+            auto slash = fname_.rfind('/');
+            auto has_ext = (dot != std::string::npos) && (slash == std::string::npos || dot > slash);
+            auto name = has_ext ? fname_.substr(0,dot) + "." + r.type() + fname_.substr(dot)
+                                : fname_ + "." + r.type() + ".csv";
+            F.s.open(name);
+            //Runs on the writer thread, so warn instead of throwing
+            if(!F.s.is_open()) std::cerr << "Warning: could not open telemetry file " << name << std::endl;
+            for(auto& f : r.fields()) F.header.push_back(f.key);
+            for(auto n : range(F.header.size()))
+                {
+                F.s << (n > 0 ? "," : "") << csvString(F.header[n]);
+                }
+            F.s << "\n";
+            it = csv_.find(r.type());
+            }
+        auto& F = it->second;
+        for(auto n : range(F.header.size()))
+            {
+            if(n > 0) F.s << ",";
+            for(auto& f : r.fields())
+                {
+                if(f.key != F.header[n]) continue;
+                F.s << csvString(f.val);
+                break;
+                }
+            }
+        F.s << "\n";
+        }
+    };
+
+struct TelemetryState
+    {
+    std::mutex mutex;
+    std::unique_ptr<TelemetryWriter> writer;
+    };
+
+//Never destroyed; pending records are written
+//at exit by the StopAtExit object below
+TelemetryState&
+telemetryState()
+    {
+    static auto* S = new TelemetryState();
+    return *S;
+    }
+
+} //namespace detail
+
+void
+startTelemetry(std::string const& fname,
+               Args const& args)
+    {
+    auto ext = fname.size() >= 4 ? fname.substr(fname.size()-4) : std::string();
+    auto format = args.getString("Format",ext == ".csv" ? "csv" : "jsonl");
+    using W = detail::TelemetryWriter;
+    if(format != "jsonl" && format != "csv") Error("Telemetry format must be \"jsonl\" or \"csv\"");
+
+    struct StopAtExit { ~StopAtExit() { stopTelemetry(); } };
+    static StopAtExit stop_at_exit;
+
+    stopTelemetry();
+    auto& S = detail::telemetryState();
+    std::lock_guard<std::mutex> lock(S.mutex);
+    S.writer = std::make_unique<W>(fname,format == "csv" ? W::CSV : W::JSONL);
+    detail::telemetry_on.store(true);
+    }
+
+void
+stopTelemetry()
+    {
+    auto& S = detail::telemetryState();
+    std::lock_guard<std::mutex> lock(S.mutex);
+    detail::telemetry_on.store(false);
+    //Destructor writes pending records
+    S.writer.reset();
+    }
+
+void
+emitTelemetry(TelemetryRecord r)
+    {
+    if(!telemetryOn()) return;
+    auto& S = detail::telemetryState();
+    std::lock_guard<std::mutex> lock(S.mutex);
+    if(S.writer) S.writer->emit(std::move(r));
+    }
+
+void
+flushTelemetry()
+    {
+    auto& S = detail::telemetryState();
+    std::lock_guard<std::mutex> lock(S.mutex);
+    if(S.writer) S.writer->flush();
+    }
+
+} //namespace itensor
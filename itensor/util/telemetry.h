@@ -0,0 +1,133 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_TELEMETRY_H
+#define __ITENSOR_TELEMETRY_H
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+#include "itensor/util/args.h"
+
+//
+// Structured telemetry
+//
+// Algorithms such as dmrg, gateTEvol and applyMPO emit
+// one record per step (bond, sweep, time step, call) with
+// named fields. Records are written to a file by a
+// background thread so the I/O does not slow down the
+// calculation:
+//
+//    startTelemetry("run.jsonl");
+//    dmrg(psi,H,sweeps);
+//    stopTelemetry();
+//
+// Formats (Args "Format", or chosen from the file extension):
+//  "jsonl": one JSON object per line, whose first field
+//           "record" is the record type, e.g. "dmrg_bond".
+//  "csv":   one file per record type, named by inserting the
+//           type before the extension ("run.csv" gives
+//           "run.dmrg_bond.csv", "run.dmrg_sweep.csv", ...).
+//           The header is taken from the first record of each
+//           type; fields not in the header are dropped.
+//
+// Telemetry is off by default; when off, emitting code
+// costs a single atomic load (check telemetryOn() before
+// assembling a record).
+//
+
+namespace itensor {
+
+class TelemetryRecord
+    {
+    public:
+
+    struct Field
+        {
+        std::string key;
+        std::string val;   //already formatted
+        bool is_string = false;
+        };
+
+    private:
+    std::string type_;
+    std::vector<Field> fields_;
+    public:
+
+    TelemetryRecord() { }
+
+    explicit
+    TelemetryRecord(std::string type) : type_(std::move(type)) { }
+
+    std::string const&
+    type() const { return type_; }
+
+    std::vector<Field> const&
+    fields() const { return fields_; }
+
+    TelemetryRecord&
+    add(std::string key, double val);
+
+    TelemetryRecord&
+    add(std::string key, long val);
+
+    TelemetryRecord&
+    add(std::string key, int val) { return add(std::move(key),long(val)); }
+
+    TelemetryRecord&
+    add(std::string key, size_t val) { return add(std::move(key),long(val)); }
+
+    TelemetryRecord&
+    add(std::string key, bool val);
+
+    TelemetryRecord&
+    add(std::string key, std::string val);
+
+    TelemetryRecord&
+    add(std::string key, const char* val) { return add(std::move(key),std::string(val)); }
+    };
+
+namespace detail {
+extern std::atomic<bool> telemetry_on;
+} //namespace detail
+
+//Start writing telemetry records to the file fname
+//(replacing any telemetry already being written).
+//Args: "Format" ("jsonl" or "csv"; default from the
+//extension of fname, "jsonl" if it is not ".csv")
+void
+startTelemetry(std::string const& fname,
+               Args const& args = Args::global());
+
+//Write all pending records and close the file(s)
+void
+stopTelemetry();
+
+bool inline
+telemetryOn() { return detail::telemetry_on.load(std::memory_order_relaxed); }
+
+//Queue a record to be written; does nothing if
+//telemetry is off
+void
+emitTelemetry(TelemetryRecord r);
+
+//Block until all records emitted so far are written
+void
+flushTelemetry();
+
+} //namespace itensor
+
+#endif
@@ -17,6 +17,7 @@
 #define __ITENSOR_TENSORSTATS_H
 
 #include <cmath>
+#include <mutex>
 #include "itensor/util/stdx.h"
 #include "itensor/util/print.h"
 #include "itensor/itensor.h"
@@ -110,10 +111,18 @@ global_tstats()
     return gts;
     }
 
+inline std::mutex&
+global_tstats_mutex()
+    {
+    static std::mutex m;
+    return m;
+    }
+
 template<typename... VArgs>
 void
 tstats(VArgs&&... vargs)
     {
+    std::lock_guard<std::mutex> lock(global_tstats_mutex());
     global_tstats().emplace_back(std::forward<VArgs&&>(vargs)...);
     }
 
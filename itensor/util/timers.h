@@ -16,6 +16,8 @@
 #ifndef __ITENSOR_TIMERS_H
 #define __ITENSOR_TIMERS_H
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include "itensor/util/stdx.h"
@@ -102,7 +104,8 @@ struct Timers
 
     ~Timers()
         {
-        if(print_on_exit_)
+        auto used = std::any_of(count_.begin(),count_.end(),[](size_type c) { return c > 0; });
+        if(print_on_exit_ && used)
             println(*this);
         }
 
@@ -185,10 +188,12 @@ struct Timers
 
     };
 
+//Each thread has its own timers, printed
+//when the thread exits if any were used
 inline GlobalTimer & 
 timers()
     {
-    static GlobalTimer timers_(true);
+    thread_local GlobalTimer timers_(true);
     return timers_;
     }
 
@@ -16,31 +16,51 @@
 #ifndef __ITENSOR_VECTOR_NO_INIT_H
 #define __ITENSOR_VECTOR_NO_INIT_H
 
+#include <type_traits>
 #include <vector>
+#include "itensor/util/storage_alloc.h"
+#include "itensor/util/memory_usage.h"
 
 namespace itensor {
 
+//The allocator holds the kind of storage its
+//memory is accounted to, see memory_usage.h.
+//Memory from one allocator can be freed by any
+//other, so all of them compare equal.
 template <class T>
 class uninitialized_allocator
   {
+  MemKind kind_ = MemOther;
   public:
   typedef T value_type;
+  using is_always_equal = std::true_type;
 
   uninitialized_allocator() noexcept { }
 
+  explicit
+  uninitialized_allocator(MemKind k) noexcept : kind_(k) { }
+
   template <class U>
-  uninitialized_allocator(uninitialized_allocator<U> const&) noexcept { }
+  uninitialized_allocator(uninitialized_allocator<U> const& a) noexcept : kind_(a.kind()) { }
+
+  MemKind
+  kind() const { return kind_; }
 
+  //Memory comes from the (caching) tensor
+  //storage allocator, see storage_alloc.h
   T*
   allocate(std::size_t n)
     {
-    return static_cast<T*>(::operator new(n * sizeof(T)));
+    auto p = allocateStorage(n * sizeof(T));
+    if(memoryTracking()) detail::memTrackAlloc(p,n * sizeof(T),kind_);
+    return static_cast<T*>(p);
     }
 
   void
-  deallocate(T* p, std::size_t) noexcept
+  deallocate(T* p, std::size_t n) noexcept
     {
-    ::operator delete(static_cast<void*>(p));
+    if(detail::memtrack_entries.load(std::memory_order_relaxed) > 0) detail::memTrackFree(p);
+    deallocateStorage(static_cast<void*>(p),n * sizeof(T));
     }
 
   template <class U>
@@ -58,17 +78,32 @@ class uninitialized_allocator
     ::new(up) U(std::forward<A0>(a0), std::forward<Args>(args)...);
     }
 
+  template <class U>
   bool
-  operator==(uninitialized_allocator<T> const&) { return true; }
+  operator==(uninitialized_allocator<U> const&) const { return true; }
 
+  template <class U>
   bool
-  operator!=(uninitialized_allocator<T> const&) { return false; }
+  operator!=(uninitialized_allocator<U> const&) const { return false; }
 
   };
 
 template<typename T>
 using vector_no_init = std::vector<T,uninitialized_allocator<T>>;
 
+//Account the memory already held by v to the
+//kind of v's allocator, for example after a
+//buffer is moved into tensor storage
+template<typename T>
+void
+trackMemKind(vector_no_init<T> const& v)
+    {
+    if(detail::memtrack_entries.load(std::memory_order_relaxed) > 0)
+        {
+        detail::memTrackSetKind(v.data(),v.get_allocator().kind());
+        }
+    }
+
 } //namespace itensor
 
 #endif
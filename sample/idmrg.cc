@@ -0,0 +1,78 @@
+#include "itensor/all.h"
+#include "Heisenberg.h"
+
+using namespace itensor;
+
+int 
+main()
+    {
+    //
+    // Two unit cells of one site each
+    //
+    int N = 2;
+    auto sites = SpinHalf(N);
+
+    //
+    // Heisenberg MPO with the boundary vectors H(0)
+    // and H(N+1) and the link after site N equal
+    // to the link before site 1
+    //
+    MPO H = Heisenberg(sites,{"Infinite=",true});
+
+    auto state = InitState(sites);
+    for(auto i : range1(N))
+        {
+        if(i%2 == 1) state.set(i,"Up");
+        else         state.set(i,"Dn");
+        }
+    auto psi = MPS(state);
+
+    //
+    // Each sweep is one iDMRG step, which
+    // grows the system by N sites
+    //
+    auto sweeps = Sweeps(40);
+    sweeps.maxdim() = 20,40,80,120;
+    sweeps.cutoff() = 1E-10;
+    sweeps.niter() = 3,2;
+    println(sweeps);
+
+    auto res = idmrg(psi,H,sweeps,{"EnergyErrgoal=",1E-10,"KeepFinite=",true});
+
+    printfln("\nGround state energy per site = %.12f",res.energy);
+    printfln("Exact (Bethe ansatz)         = %.12f",0.25-std::log(2.));
+
+    //
+    // Measure S.S on the bond between the unit cells,
+    // the center bond of the grown system
+    // (psi has its orthogonality center at site 2)
+    //
+    auto AB = psi(1)*psi(2);
+    auto SdS = 0.5*op(sites,"S+",1)*op(sites,"S-",2)
+             + 0.5*op(sites,"S-",1)*op(sites,"S+",2)
+             + op(sites,"Sz",1)*op(sites,"Sz",2);
+    auto bond = elt(dag(prime(AB,"Site"))*SdS*AB);
+    printfln("<S.S> on the center bond = %.12f",bond);
+
+    //
+    // Use the grown system to start finite DMRG
+    //
+    auto fsites = SpinHalf(res.length);
+    auto fpsi = finiteMPS(res,fsites);
+    auto ampo = AutoMPO(fsites);
+    for(auto j : range1(res.length-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    auto fH = toMPO(ampo);
+    printfln("\nFinite system of %d sites, energy from idmrg = %.12f",res.length,inner(fpsi,fH,fpsi));
+    auto fsweeps = Sweeps(2);
+    fsweeps.maxdim() = 120;
+    fsweeps.cutoff() = 1E-10;
+    auto E = dmrg(fpsi,fH,fsweeps,{"Quiet=",true});
+    printfln("Energy after finite DMRG = %.12f",E);
+
+    return 0;
+    }
@@ -0,0 +1,69 @@
+#include "itensor/all.h"
+#include "itensor/itdata/contracttrace.h"
+#include <chrono>
+
+using namespace itensor;
+
+//
+// Re-executes the contractions of a contraction trace
+// (recorded with startContractionTrace) on random data
+// and reports the time spent in them.
+//
+// Calling this code as:
+// ./replaytrace tracefile [nrepeat]
+// replays every contraction in "tracefile" nrepeat
+// times (default 1) and prints the total time, along
+// with the slowest contractions
+//
+
+int
+main(int argc, char* argv[])
+    {
+    if(argc < 2 || argc > 3)
+        {
+        println("Usage ./replaytrace tracefile [nrepeat]");
+        return 0;
+        }
+    auto nrepeat = (argc == 3) ? std::atoi(argv[2]) : 1;
+
+    auto trace = readContractionTrace(argv[1]);
+    printfln("Read %d contractions from \"%s\"",trace.size(),argv[1]);
+
+    using clock = std::chrono::steady_clock;
+    auto times = std::vector<double>(trace.size(),0.);
+    auto total = 0.;
+    auto nblocksparse = 0;
+    for(auto n : range(trace.size()))
+        {
+        auto& t = trace[n];
+        if(t.blocksparse) ++nblocksparse;
+        auto [A,B] = makeTracedTensors(t);
+        for(auto r : range(nrepeat))
+            {
+            (void)r;
+            auto start = clock::now();
+            auto C = A*B;
+            times[n] += std::chrono::duration<double>(clock::now()-start).count();
+            }
+        total += times[n];
+        }
+
+    printfln("Block sparse: %d, Dense: %d",nblocksparse,trace.size()-nblocksparse);
+    printfln("Total contraction time = %.6f s (%d repetitions)",total,nrepeat);
+
+    auto slowest = std::vector<size_t>(trace.size());
+    for(auto n : range(slowest.size())) slowest[n] = n;
+    std::sort(slowest.begin(),slowest.end(),[&](auto a, auto b) { return times[a] > times[b]; });
+    auto nshow = std::min(slowest.size(),size_t(10));
+    if(nshow > 0) println("Slowest contractions:");
+    for(auto j : range(nshow))
+        {
+        auto n = slowest[j];
+        auto& t = trace[n];
+        auto blocks = t.blocksparse ? format(", blocks %d x %d",t.Aoffsets.size(),t.Boffsets.size()) : std::string();
+        printfln("  #%d: %.6f s, order(A)=%d, order(B)=%d, size(A)=%d, size(B)=%d%s",
+                 n,times[n]/nrepeat,order(t.Ais),order(t.Bis),t.Asize,t.Bsize,blocks);
+        }
+
+    return 0;
+    }
@@ -140,6 +140,51 @@ SECTION("Chop Spaces and Equals Signs")
     CHECK(args.getInt("MaxDim")==100);
     }
 
+SECTION("ArgName")
+    {
+    auto a = ArgName("MaxDim");
+    CHECK(a == ArgName("MaxDim"));
+    CHECK(a == ArgName(std::string("MaxDim")));
+    CHECK(a != ArgName("MinDim"));
+    CHECK(a != ArgName("MaxDim="));
+    CHECK(a.str() == "MaxDim");
+    CHECK(!ArgName());
+
+    auto args = Args("MaxDim=",10,"Cutoff",1E-8);
+    CHECK(args.getInt(a) == 10);
+    CHECK(args.getInt("MaxDim") == 10);
+    CHECK(args.getInt(ArgName("MinDim"),2) == 2);
+    args.add(a,20);
+    CHECK(args.getInt("MaxDim") == 20);
+    args.remove(a);
+    CHECK(!args.defined("MaxDim"));
+    CHECK(args.defined("Cutoff"));
+    }
+
+SECTION("Copy on Write")
+    {
+    auto o1 = Args("Quiet",true,"MaxDim",10);
+    auto o2 = o1;
+    o2.add("MaxDim",20);
+    o2.add("Cutoff",1E-8);
+    CHECK(o1.getInt("MaxDim") == 10);
+    CHECK(!o1.defined("Cutoff"));
+    CHECK(o2.getInt("MaxDim") == 20);
+    CHECK(o2.getBool("Quiet"));
+
+    auto o3 = o1 + Args("Flag");
+    auto o5 = o3;
+    o5.remove("Flag");
+    CHECK(o3.defined("Flag"));
+    CHECK(!o5.defined("Flag"));
+
+    auto o4 = Args();
+    o4 += o1;
+    o1.add("MaxDim",30);
+    CHECK(o4.getInt("MaxDim") == 10);
+    CHECK(o1.getInt("MaxDim") == 30);
+    }
+
 SECTION("Read/Write")
     {
     Args o1("Quiet",true,"Sz",1,"Pinning",-0.5,"Name","name");
@@ -526,6 +526,71 @@ TEST_CASE("Contract Test")
             }
         }
 
+    SECTION("Unit Extents")
+        {
+        SECTION("Case 1")
+            {
+            //Non-matrix-like A unless extent-1 index removed
+            Tensor A(3,1,4,1),
+                   B(1,4,2),
+                   C(1,3,2,1);
+            randomize(makeRef(A));
+            randomize(makeRef(B));
+            contract(A,{1,2,3,4},B,{5,3,6},C,{4,1,6,5});
+            for(auto i1 : range(3))
+            for(auto i6 : range(2))
+                {
+                Real val = 0;
+                for(auto i3 : range(4)) val += A(i1,0,i3,0)*B(0,i3,i6);
+                CHECK_CLOSE(C(0,i1,i6,0),val);
+                }
+            }
+
+        SECTION("Case 2")
+            {
+            //All indices extent 1
+            Tensor A(1,1),
+                   B(1,1),
+                   C(1,1);
+            A(0,0) = 2.;
+            B(0,0) = 3.;
+            C(0,0) = 1.;
+            contract(A,{1,2},B,{2,3},C,{1,3},1.,1.);
+            CHECK_CLOSE(C(0,0),7.);
+            }
+        }
+
+    SECTION("Contract Batch")
+        {
+        //Batch of small contractions requiring
+        //permutations of A, B, and C, with some
+        //contractions accumulating into the same C
+        auto nbatch = 4;
+        auto As = std::vector<Tensor>(nbatch,Tensor(2,3,4)),
+             Bs = std::vector<Tensor>(nbatch,Tensor(5,3,2));
+        for(auto& A : As) randomize(makeRef(A));
+        for(auto& B : Bs) randomize(makeRef(B));
+        auto Cs = std::vector<Tensor>(2,Tensor(5,4)),
+             Ccheck = Cs;
+        auto batch = std::vector<BatchContraction<Real,Real>>{};
+        for(auto n : range(nbatch))
+            {
+            auto beta = n < 2 ? 0. : 1.;
+            batch.emplace_back(As[n].data(),Bs[n].data(),Cs[n%2].data(),beta);
+            contract(As[n],{1,2,3},Bs[n],{4,2,1},Ccheck[n%2],{4,3},2.,beta);
+            }
+        contractBatch(As[0].range(),{1,2,3},Bs[0].range(),{4,2,1},Cs[0].range(),{4,3},batch,2.);
+        for(auto c : range(2))
+            {
+            CHECK(norm(Cs[c]) > 0.);
+            for(auto i4 : range(5))
+            for(auto i3 : range(4))
+                {
+                CHECK_CLOSE(Cs[c](i4,i3),Ccheck[c](i4,i3));
+                }
+            }
+        }
+
     SECTION("Contract Loop")
         {
         SECTION("Case 1: Bik Akj = Cij")
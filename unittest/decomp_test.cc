@@ -439,6 +439,35 @@ SECTION("ITensor diagHermitian (with QNs)")
         CHECK(hasIndex(U,prime(I)));
         CHECK(norm(T-dag(U)*D*prime(U,3)) < 1E-12);
         }
+
+    SECTION("Partial Eigensolver With Truncation")
+        {
+        auto I = Index(QN(-1),6,QN(0),8,QN(+1),6,"I");
+        auto J = Index(QN(-1),5,QN(0),5,QN(+1),5,"J");
+        //Make a density matrix T from a random psi
+        auto psi = randomITensor(QN(),dag(I),J);
+        auto T = psi*dag(prime(psi,I));
+        auto args = Args("MaxDim",7,"Cutoff",1E-8);
+        ITensor U,D,Uf,Df;
+        auto spec = diagPosSemiDef(T,U,D,args);
+        auto specf = diagPosSemiDef(T,Uf,Df,Args(args,"PartialEigen",false));
+        auto d = commonIndex(U,D);
+        auto df = commonIndex(Uf,Df);
+        CHECK(dim(d) == 7);
+        CHECK(dim(d) == dim(df));
+        CHECK(nblock(d) == nblock(df));
+        for(auto b : range1(nblock(d)))
+            {
+            CHECK(qn(d,b) == qn(df,b));
+            CHECK(blocksize(d,b) == blocksize(df,b));
+            }
+        CHECK(spec.truncerr() == Approx(specf.truncerr()));
+        CHECK(norm(spec.eigsKept()-specf.eigsKept()) < 1E-10*norm(spec.eigsKept()));
+        //Projectors onto kept eigenvectors should agree
+        auto P = dag(U)*prime(U,I);
+        auto Pf = dag(Uf)*prime(Uf,I);
+        CHECK(norm(P-Pf) < 1E-10);
+        }
     }
 
 SECTION("Truncating (Special Cases)")
@@ -809,5 +838,14 @@ SECTION("Eigen")
       CHECK_CLOSE(norm(A*P - prime(P)*D),0.);
       }
 
+    SECTION("Complex Case")
+      {
+      for(auto A : {randomITensorC({Ip,I}),randomITensorC({I,Ip})})
+        {
+        auto [P,D] = eigen(A,{"Tags=","test"});
+        CHECK_CLOSE(norm(A*P - prime(P)*D),0.);
+        }
+      }
+
     }
 }
@@ -1,11 +1,14 @@
 #include "test.h"
 #include "itensor/itensor.h"
 #include "itensor/decomp.h"
+#include "itensor/contractnetwork.h"
 #include "itensor/util/cplx_literal.h"
 #include "itensor/util/iterate.h"
 #include "itensor/util/set_scoped.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/itdata/contracttrace.h"
 #include <cstdlib>
+#include <thread>
 
 using namespace std;
 using namespace itensor;
@@ -2709,6 +2712,86 @@ SECTION("removeQNs")
       CHECK(elt(Aqn,ivs)==elt(A,ivs));
   }
 
+SECTION("QN Contraction Of Non-Matrix-Like Blocks")
+  {
+  //Contracted indices in the middle of A and B,
+  //with each block used in several block contractions
+  auto i = Index(QN(-1),2,QN(0),3,QN(+1),2,"i");
+  auto j = Index(QN(-1),1,QN(0),2,QN(+1),3,"j");
+  auto k = Index(QN(-1),2,QN(0),1,QN(+1),3,"k");
+  auto l = Index(QN(-1),3,QN(0),2,QN(+1),1,"l");
+  auto m = Index(QN(0),2,QN(+1),3,"m");
+
+  auto check = [](ITensor const& A, ITensor const& B)
+      {
+      auto C = A*B;
+      auto Cd = removeQNs(A)*removeQNs(B);
+      CHECK(norm(C) > 0.);
+      CHECK(norm(removeQNs(C)-Cd) < 1E-12*norm(Cd));
+      };
+
+  SECTION("A Permuted")
+    {
+    auto A = randomITensor(QN(0),i,k,j);
+    auto B = randomITensor(QN(0),dag(k),l,m);
+    check(A,B);
+    }
+
+  SECTION("A and B Permuted")
+    {
+    auto A = randomITensor(QN(0),i,k,j,dag(l));
+    auto B = randomITensor(QN(0),m,dag(k),l,dag(i));
+    check(A,B);
+    check(A,randomITensorC(QN(0),m,dag(k),l,dag(i)));
+    }
+  }
+
+SECTION("Contraction Trace")
+  {
+  auto fname = std::string("contraction_test.trace");
+  auto i = Index(QN(-1),2,QN(0),3,QN(+1),2,"i");
+  auto j = Index(QN(0),2,QN(+1),3,"j");
+  auto k = Index(4,"k");
+  auto l = Index(5,"l");
+
+  auto A = randomITensor(QN(0),i,j,dag(prime(i)));
+  auto B = randomITensorC(QN(0),prime(i),dag(j));
+  auto D = randomITensor(k,l);
+  auto E = randomITensor(l);
+
+  startContractionTrace(fname);
+  auto AB = A*B;
+  auto DE = D*E;
+  stopContractionTrace();
+  //Not recorded
+  auto DD = D*D;
+
+  auto trace = readContractionTrace(fname);
+  std::remove(fname.c_str());
+  REQUIRE(trace.size() == 2);
+
+  auto& t0 = trace.front();
+  CHECK(t0.blocksparse);
+  CHECK(!t0.Acplx);
+  CHECK(t0.Bcplx);
+  CHECK(equals(t0.Ais,A.inds()));
+  CHECK(t0.Aoffsets.size() == nnzblocks(A));
+  auto [TA,TB] = makeTracedTensors(t0);
+  CHECK(equals(TA.inds(),A.inds()));
+  CHECK(isComplex(TB));
+  CHECK(nnzblocks(TB) == nnzblocks(B));
+  auto TC = TA*TB;
+  CHECK(hasSameInds(TC.inds(),AB.inds()));
+  CHECK(norm(TC) > 0.);
+
+  auto& t1 = trace.back();
+  CHECK(!t1.blocksparse);
+  CHECK(t1.Asize == dim(k)*dim(l));
+  auto [TD,TE] = makeTracedTensors(t1);
+  CHECK(!hasQNs(TD));
+  CHECK(hasSameInds((TD*TE).inds(),DE.inds()));
+  }
+
 SECTION("Block deficient ITensor tests")
   {
   auto i = Index(QN(0),2,QN(1),3,QN(2),4,QN(1),5,QN(3),6,"i");
@@ -2824,6 +2907,247 @@ SECTION("SVD truncation behavior")
 
   }
 
+SECTION("contractInto")
+  {
+  SECTION("Dense")
+    {
+    auto i = Index(2,"i"),
+         j = Index(3,"j"),
+         k = Index(4,"k"),
+         l = Index(5,"l");
+    auto A = randomITensor(i,j,k);
+    auto B = randomITensor(k,l);
+    auto C = randomITensor(l,i,j);
+    auto C0 = C;
+    auto* pC = C.store().get();
+    contractInto(A,B,C,2.,0.5);
+    CHECK(C.store().get() != pC); //storage was shared with C0
+    CHECK(order(C) == 3);
+    CHECK(C.inds()[0] == l);
+    CHECK(norm(C-(2*A*B+0.5*C0)) < 1E-12);
+
+    pC = C.store().get();
+    contractInto(A,B,C);
+    CHECK(C.store().get() == pC);
+    CHECK(norm(C-A*B) < 1E-12);
+
+    auto Z = randomITensorC(k,l);
+    auto CZ = ITensor{};
+    contractInto(A,Z,CZ);
+    CHECK(norm(CZ-A*Z) < 1E-12);
+    contractInto(A,Z,CZ,1.,1.);
+    CHECK(isComplex(CZ));
+    CHECK(norm(CZ-2*A*Z) < 1E-12);
+
+    //Real C can't hold the complex product
+    contractInto(A,Z,C);
+    CHECK(isComplex(C));
+    CHECK(norm(C-A*Z) < 1E-12);
+
+    //Indices of C don't match
+    auto D = randomITensor(i,j);
+    contractInto(A,B,D);
+    CHECK(hasInds(D,{i,j,l}));
+    CHECK(norm(D-A*B) < 1E-12);
+
+    //Order of C requires permuting the gemm result
+    auto A2 = randomITensor(i,k,j);
+    auto E = randomITensor(j,l,i);
+    auto E0 = E;
+    contractInto(A2,B,E,1.,1.);
+    CHECK(norm(E-(E0+A2*B)) < 1E-12);
+    contractInto(A2,B,E,2.,-0.5);
+    CHECK(norm(E-(2*A2*B-0.5*(E0+A2*B))) < 1E-12);
+    }
+
+  SECTION("QDense")
+    {
+    auto i = Index(QN(0),2,QN(1),2,"i"),
+         j = Index(QN(0),2,QN(1),3,"j"),
+         k = Index(QN(0),1,QN(1),2,"k");
+    auto A = randomITensor(QN(),i,dag(j),k);
+    auto B = randomITensor(QN(1),j,dag(prime(i)));
+    auto C = A*B;
+    auto C0 = C;
+    auto* pC = C.store().get();
+    contractInto(A,B,C,-1.,3.);
+    CHECK(C.store().get() != pC);
+    CHECK(norm(C-(3*C0-A*B)) < 1E-12);
+
+    pC = C.store().get();
+    contractInto(A,B,C);
+    CHECK(C.store().get() == pC);
+    CHECK(norm(C-A*B) < 1E-12);
+    CHECK(div(C) == div(A*B));
+
+    //Different block structure
+    auto B2 = randomITensor(QN(0),j,dag(prime(i)));
+    contractInto(A,B2,C);
+    CHECK(norm(C-A*B2) < 1E-12);
+    CHECK(div(C) == div(A*B2));
+    }
+  }
+
+SECTION("dot and dotC")
+  {
+  SECTION("Dense")
+    {
+    auto i = Index(2,"i"),
+         j = Index(3,"j"),
+         k = Index(4,"k");
+    auto A = randomITensor(i,j,k);
+    auto B = randomITensor(i,j,k);
+    auto Bp = permute(B,k,i,j);
+    auto ZA = randomITensorC(i,j,k);
+    auto ZB = randomITensorC(j,k,i);
+    CHECK_CLOSE(dot(A,B),elt(A*B));
+    CHECK_CLOSE(dot(A,Bp),elt(A*B));
+    CHECK_CLOSE(dot(A,A),sqr(norm(A)));
+    CHECK_CLOSE(dotC(ZA,ZB),eltC(dag(ZA)*ZB));
+    CHECK_CLOSE(dotC(A,ZB),eltC(A*ZB));
+    CHECK_CLOSE(dotC(ZA,B),eltC(dag(ZA)*B));
+
+    auto s = ITensor(3.);
+    CHECK_CLOSE(dot(s,ITensor(2.)),6.);
+    }
+
+  SECTION("QDense")
+    {
+    auto i = Index(QN(0),2,QN(1),2,"i"),
+         j = Index(QN(0),2,QN(1),3,"j"),
+         k = Index(QN(0),1,QN(1),2,"k");
+    auto A = randomITensor(QN(),i,dag(j),k);
+    auto B = randomITensor(QN(),i,dag(j),k);
+    auto ZB = randomITensorC(QN(),i,dag(j),k);
+    CHECK_CLOSE(dot(A,B),elt(dag(A)*B));
+    CHECK_CLOSE(dot(A,permute(B,k,i,j)),elt(dag(A)*B));
+    CHECK_CLOSE(dotC(ZB,A),eltC(dag(ZB)*A));
+    CHECK_CLOSE(dotC(ZB,ZB),sqr(norm(ZB)));
+    //Blocks of A with no match in B don't contribute
+    auto C = randomITensor(QN(1),i,dag(j),k);
+    CHECK_CLOSE(dot(A,C),0.);
+    }
+
+  SECTION("Threaded")
+    {
+    auto i = Index(64,"i"),
+         j = Index(64,"j"),
+         k = Index(64,"k");
+    auto A = randomITensor(i,j,k);
+    auto B = randomITensor(k,i,j);
+    auto ref = dot(A,B,{"NThread=",1});
+    CHECK_CLOSE(dot(A,B,{"NThread=",4}),ref);
+    CHECK_CLOSE(ref,elt(A*B));
+    }
+  }
+
+SECTION("contractNetwork")
+  {
+  SECTION("Order")
+    {
+    auto i = Index(20,"i"),
+         j = Index(2,"j"),
+         k = Index(2,"k"),
+         l = Index(20,"l");
+    auto A = randomITensor(i,j);
+    auto B = randomITensor(k,l);
+    auto C = randomITensor(j,k);
+    auto inds = std::vector<IndexSet>{A.inds(),B.inds(),C.inds()};
+    auto order = contractionOrder(inds);
+    CHECK(order.size() == 2);
+    auto ltr = std::vector<std::pair<int,int>>{{0,1},{3,2}};
+    CHECK(contractionCost(inds,order) < contractionCost(inds,ltr));
+
+    auto scratch = NetworkScratch{};
+    auto R = ITensor{};
+    contractNetwork({&A,&B,&C},R,scratch);
+    CHECK(hasInds(R,{i,l}));
+    CHECK(norm(R-A*B*C) < 1E-11);
+
+    //Equal costs keep the left-to-right order
+    auto m = Index(2,"m"),
+         n = Index(2,"n");
+    auto eq = std::vector<IndexSet>{IndexSet(n,j),IndexSet(j,k),IndexSet(k,m)};
+    CHECK(contractionOrder(eq) == ltr);
+    }
+
+  SECTION("Environment")
+    {
+    auto a = Index(QN(0),3,QN(1),4,QN(2),3,"a"),
+         b = Index(QN(0),2,QN(1),5,QN(2),2,"b"),
+         w = Index(QN(0),4,"w"),
+         v = Index(QN(0),4,"v"),
+         s = Index(QN(0),1,QN(1),1,"s");
+    auto E = randomITensor(QN(),dag(a),w,prime(a));
+    auto A = randomITensor(QN(),a,s,dag(b));
+    auto W = randomITensor(QN(),dag(w),prime(s),dag(s),v);
+    auto Ad = dag(prime(A));
+    auto scratch = NetworkScratch{};
+    auto nE = ITensor{};
+    contractNetwork({&E,&A,&W,&Ad},nE,scratch);
+    auto nE0 = E*A*W*Ad;
+    CHECK(norm(nE-nE0) < 1E-10*norm(nE0));
+    CHECK(scratch.size() == 2);
+
+    //Same indices: results are written in place
+    auto* pE = nE.store().get();
+    A.randomize();
+    Ad = dag(prime(A));
+    contractNetwork({&E,&A,&W,&Ad},nE,scratch);
+    CHECK(nE.store().get() == pE);
+    nE0 = E*A*W*Ad;
+    CHECK(norm(nE-nE0) < 1E-10*norm(nE0));
+
+    //Default constructed factors are skipped
+    //and the result may be one of the factors
+    auto R = ITensor{};
+    contractNetwork({&R,&A,&Ad},R,scratch);
+    CHECK(norm(R-A*Ad) < 1E-10*norm(R));
+    auto R0 = R;
+    contractNetwork({&R,&E},R,scratch);
+    CHECK(norm(R-R0*E) < 1E-10*norm(R));
+    }
+  }
+
+SECTION("Concurrent Copy on Write")
+  {
+  //Threads modify their own copies of tensors whose
+  //storage is shared; the originals must not change
+  auto i = Index(QN(0),2,QN(1),2,"i");
+  auto j = Index(QN(0),2,QN(1),2,"j");
+  auto A = randomITensor(QN(),i,dag(j));
+  auto k = Index(3,"k");
+  auto B = randomITensor(k,prime(k));
+  auto nA = norm(A);
+  auto nB = norm(B);
+
+  int nthread = 4;
+  auto ok = std::vector<int>(nthread,0);
+  auto threads = std::vector<std::thread>{};
+  for(auto t : range(nthread))
+      {
+      threads.emplace_back([&,t]
+          {
+          bool good = true;
+          for(int n = 0; n < 200; ++n)
+              {
+              auto a = A;
+              auto b = B;
+              a *= (t+2.);
+              b.set(1,1,100.);
+              good = good && std::fabs(norm(a)-(t+2.)*nA) < 1E-10;
+              good = good && b.real(1,1) == 100.;
+              }
+          ok[t] = good;
+          });
+      }
+  for(auto& th : threads) th.join();
+
+  for(auto t : range(nthread)) CHECK(ok[t]);
+  CHECK_CLOSE(norm(A),nA);
+  CHECK_CLOSE(norm(B),nB);
+  }
+
 } //TEST_CASE("ITensor")
 
 
@@ -143,6 +143,28 @@ SECTION("LocalOp: check product")
   CHECK_CLOSE(norm(Hpsi2-noPrime(psi2*L0*Op1*Op2*R2)),0.);
   }
 
+SECTION("Work Freed On Update")
+    {
+    auto Op1 = randomITensor(s1,prime(s1),h0,h1);
+    auto Op2 = randomITensor(s2,prime(s2),h1,h2);
+    auto L = randomITensor(l0,prime(l0),h0);
+    auto R = randomITensor(l2,prime(l2),h2);
+    auto psi = randomITensor(l0,s1,s2,l2);
+    auto lop = LocalOp(Op1,Op2,L,R,{"NumCenter=",2});
+    auto phip = ITensor{};
+    setMemoryTracking(true);
+    auto start = memoryUsage().live;
+    lop.product(psi,phip);
+    auto after = memoryUsage().live;
+    //product keeps its intermediates for reuse
+    CHECK(after > start+sizeof(Real)*dim(inds(phip)));
+    lop.product(psi,phip);
+    CHECK(memoryUsage().live == after);
+    lop.update(Op1,Op2,L,R);
+    CHECK(memoryUsage().live == start+sizeof(Real)*dim(inds(phip)));
+    setMemoryTracking(false);
+    }
+
 SECTION("Diag")
     {
     SECTION("Bulk Case - ITensor")
@@ -351,6 +373,82 @@ SECTION("LocalMPOSet")
     CHECK_CLOSE(norm(Hphi-noPrime(phi*Hpsi.L()[0]*H[0](b)*H[0](b+1)*Hpsi.R()[0]+
                                   phi*Hpsi.L()[1]*H[1](b)*H[1](b+1)*Hpsi.R()[1])),0.);
     }
+
+  SECTION("Concurrent")
+    {
+    //Large enough tensors to use threads
+    auto Nc = 14;
+    auto csites = SpinHalf(Nc,{"ConserveQNs=",false});
+    auto Hc = std::vector<MPO>{};
+    for(auto p : range(4))
+        {
+        auto ampo = AutoMPO(csites);
+        for(int j = 1+p; j < Nc; j += 4)
+            {
+            ampo += 0.5,"S+",j,"S-",j+1;
+            ampo += 0.5,"S-",j,"S+",j+1;
+            ampo +=     "Sz",j,"Sz",j+1;
+            }
+        Hc.push_back(toMPO(ampo));
+        }
+    auto cpsi = MPS(csites);
+    auto links = std::vector<Index>(Nc+1);
+    for(auto j : range1(Nc-1))
+        {
+        auto m = std::min({1l << j,1l << (Nc-j),32l});
+        links[j] = Index(m,format("Link,l=%d",j));
+        }
+    for(auto j : range1(Nc))
+        {
+        auto is = IndexSet(csites(j));
+        if(j > 1) is = IndexSet(links[j-1],csites(j));
+        if(j < Nc) is = IndexSet(is,links[j]);
+        cpsi.ref(j) = randomITensor(is);
+        }
+    cpsi.leftLim(0);
+    cpsi.rightLim(Nc+1);
+    auto bc = 6;
+    cpsi.position(bc);
+
+    auto PH1 = LocalMPOSet(Hc,{"NThread=",1});
+    auto PH4 = LocalMPOSet(Hc,{"NThread=",4});
+    CHECK(PH4.nthread() == 4);
+    CHECK(LocalMPOSet(Hc).nthread() == 1);
+    PH1.position(bc,cpsi);
+    PH4.position(bc,cpsi);
+
+    auto phi = cpsi(bc)*cpsi(bc+1);
+    phi /= norm(phi);
+    CHECK(dim(inds(phi)) >= 4096);
+    auto Hphi1 = ITensor{},
+         Hphi4 = ITensor{};
+    PH1.product(phi,Hphi1);
+    PH4.product(phi,Hphi4);
+    CHECK(norm(Hphi4-Hphi1) < 1E-12*norm(Hphi1));
+    CHECK_CLOSE(PH4.expect(phi),PH1.expect(phi));
+    CHECK_CLOSE(PH4.expect(phi),dot(phi,Hphi1));
+
+    //Worker threads follow the caller's gemm precision
+    auto Sphi1 = ITensor{},
+         Sphi4 = ITensor{};
+        {
+        SET_SCOPED(gemmSinglePrecision()) = true;
+        PH1.product(phi,Sphi1);
+        PH4.product(phi,Sphi4);
+        }
+    CHECK(norm(Sphi1-Hphi1) > 1E-10*norm(Hphi1));
+    CHECK(norm(Sphi1-Hphi1) < 1E-4*norm(Hphi1));
+    CHECK(norm(Sphi4-Sphi1) < 1E-12*norm(Sphi1));
+
+    //Shift the environments one site right
+    auto [U,S,V] = svd(phi,inds(cpsi(bc)),{"MaxDim=",32});
+    PH1.shift(bc,Fromleft,U);
+    PH4.shift(bc,Fromleft,U);
+    for(auto n : range(Hc.size()))
+        {
+        CHECK(norm(PH4.L()[n]-PH1.L()[n]) < 1E-12*norm(PH1.L()[n]));
+        }
+    }
   }
 }
 
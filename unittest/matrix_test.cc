@@ -4,6 +4,9 @@
 #include "itensor/util/iterate.h"
 #include "itensor/tensor/algs.h"
 #include "itensor/global.h"
+#include "itensor/util/set_scoped.h"
+#include "itensor/tensor/lapack_wrap.h"
+#include "itensor/util/memory_usage.h"
 
 using namespace itensor;
 using namespace std;
@@ -885,6 +888,40 @@ SECTION("Test MatrixRef mult")
             CHECK_CLOSE(C(r,c),val);
             }
         }
+
+    SECTION("Single precision")
+        {
+        auto N = 20;
+        auto dataA = randomData<Real>(N*N);
+        auto dataB = randomData<Real>(N*N);
+        auto dataC = randomData<Real>(N*N);
+        auto dataS = randomData<Real>(N*N);
+
+        auto A = makeMatRef(dataA.begin(),dataA.size(),N,N);
+        auto B = makeMatRef(dataB.begin(),dataB.size(),N,N);
+        auto C = makeMatRef(dataC.begin(),dataC.size(),N,N);
+        auto S = makeMatRef(dataS.begin(),dataS.size(),N,N);
+
+        mult(A,B,C);
+        setMemoryTracking(true);
+        resetMemoryPeaks();
+        auto scratch = memoryUsage(MemScratch).live;
+            {
+            SET_SCOPED(gemmSinglePrecision()) = true;
+            mult(A,B,S);
+            }
+        setMemoryTracking(false);
+        CHECK(!gemmSinglePrecision());
+        //Single precision copies are tracked scratch,
+        //freed once the product is done
+        CHECK(memoryUsage(MemScratch).peak >= scratch+3*N*N*sizeof(float));
+        CHECK(memoryUsage(MemScratch).live == scratch);
+        for(auto r : range(nrows(C)))
+        for(auto c : range(ncols(C)))
+            {
+            CHECK_DIFF(S(r,c),C(r,c),1E-8);
+            }
+        }
     }
 
 SECTION("Test multAdd")
@@ -1409,6 +1446,62 @@ SECTION("diagHermitian")
 
         CHECK(norm(R-Mt) < 1E-12*norm(Mt));
         }
+
+    SECTION("Eigenvalues only")
+        {
+        auto M = randomMatC(N,N);
+        M = M+conj(transpose(M));
+
+        CMatrix U;
+        Vector d,e;
+        diagHermitian(M,U,d);
+        eigvalsHermitian(M,e);
+        CHECK(e.size() == d.size());
+        CHECK(norm(e-d) < 1E-12*norm(d));
+        }
+
+    SECTION("Partial real case")
+        {
+        auto M = randomMat(N,N);
+        M = M+transpose(M);
+
+        Matrix U,Up;
+        Vector d,dp;
+        diagHermitian(M,U,d);
+        auto nvec = 4;
+        diagHermitian(M,Up,dp,nvec);
+        CHECK(nrows(Up) == N);
+        CHECK(ncols(Up) == nvec);
+        CHECK(dp.size() == nvec);
+        for(auto n : range(nvec))
+            {
+            CHECK_CLOSE(dp(n),d(n));
+            }
+        auto Dp = Matrix(nvec,nvec);
+        diagonal(Dp) &= dp;
+        CHECK(norm(transpose(Up)*M*Up-Dp) < 1E-12*norm(M));
+        }
+
+    SECTION("Partial complex case")
+        {
+        auto M = randomMatC(N,N);
+        M = M+conj(transpose(M));
+
+        CMatrix Up;
+        Vector d,dp;
+        eigvalsHermitian(M,d);
+        auto nvec = 3;
+        diagHermitian(M,Up,dp,nvec);
+        //R should be diagonal with the nvec 
+        //largest eigenvalues on the diagonal
+        auto R = conj(transpose(Up))*M*Up;
+        for(auto n : range(nvec))
+            {
+            CHECK_CLOSE(dp(n),d(n));
+            CHECK_CLOSE(R(n,n),dp(n));
+            }
+        CHECK_CLOSE(norm(R),norm(dp));
+        }
     }
 
 SECTION("expMatrix")
@@ -7,11 +7,52 @@
 #include "itensor/mps/sites/electron.h"
 #include "itensor/mps/autompo.h"
 #include "itensor/mps/dmrg.h"
+#include "itensor/mps/idmrg.h"
+#include "itensor/mps/metts.h"
 #include "mps_mpo_test_helper.h"
+#include <fstream>
+#include <thread>
 
 using namespace itensor;
 using namespace std;
 
+//Heisenberg MPO for idmrg: the link after the last
+//site is the link before the first, and H(0), H(N+1)
+//are the boundary vectors
+MPO
+infiniteHeisenberg(SiteSet const& sites)
+    {
+    auto N = length(sites);
+    auto H = MPO(sites);
+    auto links = std::vector<Index>(N);
+    for(auto l : range(N))
+        {
+        links[l] = Index(QN({"Sz", 0}),3,
+                         QN({"Sz",-2}),1,
+                         QN({"Sz",+2}),1,
+                         Out,
+                         format("Link,l=%d",l));
+        }
+    for(auto n : range1(N))
+        {
+        auto row = dag(links[n-1]);
+        auto col = links[n%N];
+        auto& W = H.ref(n);
+        W = ITensor(dag(sites(n)),prime(sites(n)),row,col);
+        W += sites.op("Id",n)*setElt(row(1))*setElt(col(1));
+        W += sites.op("Id",n)*setElt(row(2))*setElt(col(2));
+        W += sites.op("Sz",n)*setElt(row(3))*setElt(col(1));
+        W += sites.op("Sz",n)*setElt(row(2))*setElt(col(3));
+        W += sites.op("Sm",n)*setElt(row(4))*setElt(col(1));
+        W += sites.op("Sp",n)*setElt(row(2))*setElt(col(4))*0.5;
+        W += sites.op("Sp",n)*setElt(row(5))*setElt(col(1));
+        W += sites.op("Sm",n)*setElt(row(2))*setElt(col(5))*0.5;
+        }
+    H.ref(0) = setElt(links[0](2));
+    H.ref(N+1) = setElt(dag(links[0])(1));
+    return H;
+    }
+
 TEST_CASE("MPOTest")
 {
 
@@ -601,4 +642,323 @@ SECTION("DMRG with QNs")
   CHECK_CLOSE((energy-energy_exact)/energy_exact,0.);
   }
 
+
+SECTION("DMRG with mixed precision")
+  {
+  int N = 20;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto psi0 = randomMPS(sites);
+
+  auto h = 0.5;
+
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j)
+      {
+      ampo += -1.0,"Sx",j,"Sx",j+1;
+      ampo += -h,"Sz",j;
+      }
+  ampo += -h,"Sz",N;
+  auto H = toMPO(ampo);
+
+  //Early sweeps in single precision, last
+  //sweeps refine in double precision
+  auto sweeps = Sweeps(5);
+  sweeps.maxdim() = 10,20,30;
+  sweeps.cutoff() = 1E-12;
+  sweeps.precision() = 32,32,64;
+  CHECK(sweeps.precision(1) == 32);
+  CHECK(sweeps.precision(5) == 64);
+  auto [Energy,psi] = dmrg(H,psi0,sweeps,{"Silent",true});
+  auto energy = Energy/N;
+  (void)psi;
+  CHECK(!gemmSinglePrecision());
+
+  auto Energy_exact = 1.0 - 1.0/sin(Pi/(2*(2*N+1)));
+  auto energy_exact = Energy_exact/(4*N);
+  CHECK_CLOSE((energy-energy_exact)/energy_exact,0.);
+
+  //Precision schedule is saved with the sweeps
+  auto ss = std::stringstream{};
+  sweeps.write(ss);
+  auto rsweeps = Sweeps{};
+  rsweeps.read(ss);
+  CHECK(rsweeps.nsweep() == 5);
+  CHECK(rsweeps.maxdim(2) == 20);
+  CHECK(rsweeps.precision(1) == 32);
+  CHECK(rsweeps.precision(5) == 64);
+
+  //Sweeps written before precision was added
+  auto os = std::stringstream{};
+  write(os,std::vector<int>{0,10,20});
+  write(os,std::vector<int>(3,1));
+  write(os,std::vector<Real>(3,1E-12));
+  write(os,std::vector<int>(3,2));
+  write(os,std::vector<Real>(3,0.));
+  write(os,2);
+  rsweeps.read(os);
+  CHECK(rsweeps.nsweep() == 2);
+  CHECK(rsweeps.maxdim(2) == 20);
+  CHECK(rsweeps.precision(2) == 64);
+  }
+
+
+SECTION("Concurrent DMRG")
+  {
+  //Several DMRG calculations on separate threads, all
+  //starting from copies of the same MPO and MPS (so
+  //their storage is shared until modified), one of
+  //them in mixed precision
+  int N = 16;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto h = 0.5;
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j)
+      {
+      ampo += -1.0,"Sx",j,"Sx",j+1;
+      ampo += -h,"Sz",j;
+      }
+  ampo += -h,"Sz",N;
+  auto H = toMPO(ampo);
+  auto psi0 = randomMPS(sites);
+
+  int nthread = 4;
+  auto energies = std::vector<Real>(nthread);
+  auto threads = std::vector<std::thread>{};
+  for(auto t : range(nthread))
+      {
+      threads.emplace_back([&,t]
+          {
+          auto sweeps = Sweeps(5);
+          sweeps.maxdim() = 10,20,30;
+          sweeps.cutoff() = 1E-12;
+          if(t == 0) sweeps.precision() = 32,32,64;
+          auto [E,psi] = dmrg(H,psi0,sweeps,{"Silent",true});
+          energies[t] = E;
+          (void)psi;
+          });
+      }
+  for(auto& th : threads) th.join();
+
+  auto Energy_exact = 1.0 - 1.0/sin(Pi/(2*(2*N+1)));
+  for(auto E : energies)
+      {
+      CHECK_CLOSE((E/N-Energy_exact/(4*N))/(Energy_exact/(4*N)),0.);
+      }
+  CHECK(!gemmSinglePrecision());
+  }
+
+SECTION("DMRG Perf Counters")
+  {
+  int N = 10;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j) ampo += "Sz",j,"Sz",j+1;
+  auto H = toMPO(ampo);
+  auto psi = randomMPS(sites);
+
+  auto sweeps = Sweeps(2);
+  sweeps.maxdim() = 10;
+  auto obs = DMRGObserver(psi);
+  setPerfCounting(true);
+  dmrg(psi,H,sweeps,obs,{"Silent",true});
+  setPerfCounting(false);
+  auto& P = obs.sweepPerf();
+  CHECK(P[PerfContract].calls > 0);
+  CHECK(P[PerfGemm].flops > 0);
+  CHECK(P[PerfFactorize].calls > 0);
+  CHECK(P[PerfGemm].time > 0);
+  }
+
+SECTION("DMRG Memory Limit")
+  {
+  int N = 10;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j) ampo += "Sz",j,"Sz",j+1;
+  for(int j = 1; j < N; ++j) ampo += 0.5,"S+",j,"S-",j+1;
+  for(int j = 1; j < N; ++j) ampo += 0.5,"S-",j,"S+",j+1;
+  auto H = toMPO(ampo);
+  auto psi0 = randomMPS(sites);
+
+  auto sweeps = Sweeps(4);
+  sweeps.maxdim() = 10,20;
+  sweeps.cutoff() = 1E-10;
+  auto psi1 = psi0;
+  auto E1 = dmrg(psi1,H,sweeps,{"Silent",true});
+
+  //Exceeding the limit moves environments to disk
+  //mid-sweep, which should not change the result
+  setMemoryLimit(1);
+  auto psi2 = psi0;
+  auto E2 = dmrg(psi2,H,sweeps,{"Silent",true,"WriteDir","/tmp/"});
+  setMemoryLimit(0);
+  setMemoryTracking(false);
+  CHECK_CLOSE(E1,E2);
+  CHECK(memoryUsage("environment").peak > 0);
+  }
+
+SECTION("DMRG Telemetry")
+  {
+  int N = 6;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j) ampo += "Sz",j,"Sz",j+1;
+  auto H = toMPO(ampo);
+  auto psi = randomMPS(sites);
+
+  auto fname = std::string("dmrg_telemetry_test.jsonl");
+  startTelemetry(fname);
+  auto sweeps = Sweeps(2);
+  sweeps.maxdim() = 10;
+  dmrg(psi,H,sweeps,{"Silent",true});
+  stopTelemetry();
+
+  auto nbond = 0,
+       nsweep = 0;
+  auto f = std::ifstream(fname);
+  for(std::string l; std::getline(f,l);)
+      {
+      if(l.find("\"record\":\"dmrg_bond\"") != std::string::npos) ++nbond;
+      if(l.find("\"record\":\"dmrg_sweep\"") != std::string::npos) ++nsweep;
+      CHECK(l.find("\"energy\":") != std::string::npos);
+      }
+  CHECK(nbond == 2*2*(N-1));
+  CHECK(nsweep == 2);
+  std::remove(fname.c_str());
+  }
+
+SECTION("iDMRG")
+  {
+  auto sites = SpinHalf(2);
+  auto H = infiniteHeisenberg(sites);
+  auto state = InitState(sites);
+  state.set(1,"Up");
+  state.set(2,"Dn");
+  auto psi = MPS(state);
+  auto sweeps = Sweeps(20);
+  sweeps.maxdim() = 10,20,30;
+  sweeps.cutoff() = 1E-10;
+  sweeps.niter() = 3;
+  auto res = idmrg(psi,H,sweeps,{"Quiet",true,"KeepFinite",true});
+
+  //Bethe ansatz energy per site 1/4-log(2)
+  CHECK(std::fabs(res.energy-(0.25-std::log(2.))) < 1E-3);
+  CHECK(res.length == 40);
+  CHECK(isOrtho(psi));
+  CHECK(orthoCenter(psi) == 2);
+  CHECK(order(res.center) == 2);
+
+  //The grown system as a finite MPS, used to start dmrg
+  auto fsites = SpinHalf(res.length);
+  auto fpsi = finiteMPS(res,fsites);
+  CHECK_CLOSE(norm(fpsi),1.);
+  auto ampo = AutoMPO(fsites);
+  for(auto j : range1(res.length-1))
+      {
+      ampo += 0.5,"S+",j,"S-",j+1;
+      ampo += 0.5,"S-",j,"S+",j+1;
+      ampo +=     "Sz",j,"Sz",j+1;
+      }
+  auto fH = toMPO(ampo);
+  auto E0 = inner(fpsi,fH,fpsi);
+  CHECK(std::fabs(E0-res.total_energy) < 1E-6*std::fabs(E0));
+  auto fsweeps = Sweeps(2);
+  fsweeps.maxdim() = 30;
+  fsweeps.cutoff() = 1E-10;
+  auto E = dmrg(fpsi,fH,fsweeps,{"Silent",true});
+  CHECK(E <= E0+1E-8);
+  }
+
+SECTION("METTS collapse")
+  {
+  auto N = 4;
+  auto sites = SpinHalf(N);
+  auto ampo = AutoMPO(sites);
+  for(auto j : range1(N-1))
+      {
+      ampo += 0.5,"S+",j,"S-",j+1;
+      ampo += 0.5,"S-",j,"S+",j+1;
+      ampo +=     "Sz",j,"Sz",j+1;
+      }
+  auto state = InitState(sites);
+  for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+  auto psi = MPS(state);
+  mettsMPOEvolver(toExpH(ampo,0.1),10,{"Cutoff=",1E-12})(psi);
+  CHECK(maxLinkDim(psi) > 1);
+
+  //Probability of Up,Dn,Up,Dn
+  auto p = std::pow(std::fabs(innerC(MPS(state),psi)),2);
+  auto rng = RandomStream(1,1);
+  auto nsample = 2000;
+  auto count = 0;
+  for(auto n : range(nsample))
+      {
+      (void)n;
+      auto phi = psi;
+      auto st = collapse(phi,rng);
+      CHECK(st.size() == size_t(N+1));
+      CHECK(maxLinkDim(phi) == 1);
+      CHECK_CLOSE(norm(phi),1.);
+      //Sz is conserved by the collapse
+      auto nup = 0;
+      for(auto j : range1(N)) nup += (st[j] == 1);
+      CHECK(nup == N/2);
+      if(st[1] == 1 && st[2] == 2 && st[3] == 1 && st[4] == 2)
+          {
+          ++count;
+          CHECK_CLOSE(std::fabs(innerC(MPS(state),phi)),1.);
+          }
+      }
+  CHECK(std::fabs(Real(count)/nsample-p) < 4*std::sqrt(p*(1-p)/nsample));
+  }
+
+SECTION("METTS")
+  {
+  auto N = 4;
+  auto beta = 1.;
+  auto tau = 0.05;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto ampo = AutoMPO(sites);
+  for(auto j : range1(N-1))
+      {
+      ampo += 0.5,"S+",j,"S-",j+1;
+      ampo += 0.5,"S-",j,"S+",j+1;
+      ampo +=     "Sz",j,"Sz",j+1;
+      }
+  auto H = toMPO(ampo);
+
+  //Exact thermal energy
+  auto Hfull = H(1);
+  for(auto j : range1(2,N)) Hfull *= H(j);
+  auto U = ITensor{},
+       D = ITensor{};
+  std::tie(U,D) = diagHermitian(Hfull);
+  auto l = commonIndex(U,D);
+  Real Z = 0.,
+       EZ = 0.;
+  for(auto k : range1(dim(l)))
+      {
+      auto e = elt(D,l(k),prime(l)(k));
+      Z += std::exp(-beta*e);
+      EZ += e*std::exp(-beta*e);
+      }
+
+  auto expH = toExpH(ampo,tau);
+  auto evolve = mettsMPOEvolver(expH,int(beta/(2*tau)+0.5),{"Cutoff=",1E-12,"MaxDim=",100});
+  auto obs = std::vector<METTSObservable>{{"Energy",[&H](MPS const& phi) { return inner(phi,H,phi); }}};
+  auto state = InitState(sites,"Up");
+  auto psi0 = MPS(state);
+  auto args = Args("NChain=",4,"NMETTS=",100,"NWarm=",2,"Basis=","Alternate");
+  auto res = metts(psi0,evolve,obs,{args,"NThread=",2});
+  CHECK(res.names.at(0) == "Energy");
+  CHECK(res("Energy").dat.size() == 400u);
+  CHECK(res.chain_stats.size() == 4u);
+  CHECK(std::fabs(res("Energy").avg()-EZ/Z) < 4*res("Energy").err());
+
+  //Chains use their own random streams, so the
+  //number of threads does not change the results
+  auto res1 = metts(psi0,evolve,obs,{args,"NThread=",1});
+  CHECK(res1("Energy").dat == res("Energy").dat);
+  }
+
 }
@@ -1,7 +1,10 @@
 #include "test.h"
+#include <map>
 #include "itensor/mps/mps.h"
 #include "itensor/mps/sites/spinhalf.h"
 #include "itensor/mps/sites/fermion.h"
+#include "itensor/mps/sites/electron.h"
+#include "itensor/mps/mpo.h"
 #include "itensor/util/print_macro.h"
 #include "itensor/util/str.h"
 #include "mps_mpo_test_helper.h"
@@ -99,6 +102,11 @@ SECTION("Random constructors (dim==1)")
     CHECK(checkTags(psi1));
     CHECK_CLOSE(diff(psi,psi1),0.);
 
+    //Overlap with a complex phase
+    auto phi = psi;
+    phi.ref(N) *= std::exp(0.3*Complex_i);
+    CHECK_CLOSE(innerC(psi,phi),std::exp(0.3*Complex_i)*norm2);
+
     psi1.position(N);
 
     norm2 = innerC(psi1,psi1);
@@ -375,4 +383,169 @@ SECTION("prime")
 
     }
 
+SECTION("expect and correlationMatrix")
+    {
+    auto Nc = 6;
+
+    //Entangled state with the given QNs: a sum of product
+    //states evolved by exp(-H) with hopping terms
+    auto evolved = [Nc](SiteSet const& sites,
+                        std::vector<std::vector<std::string>> const& states,
+                        std::vector<std::string> const& hop)
+        {
+        auto terms = std::vector<MPS>{};
+        for(auto& st : states)
+            {
+            auto init = InitState(sites);
+            for(auto j : range1(Nc)) init.set(j,st.at(j-1));
+            terms.push_back(MPS(init));
+            }
+        auto psi = sum(terms);
+        auto ampo = AutoMPO(sites);
+        for(auto j : range1(Nc-1))
+            {
+            ampo += -1.0,hop[0],j,hop[1],j+1;
+            ampo += -1.0,hop[1],j,hop[0],j+1;
+            }
+        auto expH = toExpH(ampo,0.2);
+        for(auto n : range(4))
+            {
+            (void)n;
+            psi = applyMPO(expH,psi,{"Cutoff=",1E-14});
+            psi.noPrime();
+            }
+        return psi;
+        };
+
+    //<psi|Op1_i Op2_j|psi>/<psi|psi> from AutoMPO
+    auto corr = [Nc](SiteSet const& sites, MPS const& psi,
+                     std::string const& Op1, std::string const& Op2)
+        {
+        auto res = Matrix(Nc,Nc);
+        for(auto i : range1(Nc))
+        for(auto j : range1(Nc))
+            {
+            auto ampo = AutoMPO(sites);
+            ampo += Op1,i,Op2,j;
+            res(i-1,j-1) = inner(psi,toMPO(ampo),psi)/inner(psi,psi);
+            }
+        return res;
+        };
+
+    auto checkCorr = [Nc,&corr](SiteSet const& sites, MPS const& psi,
+                                std::string const& Op1, std::string const& Op2)
+        {
+        auto C = correlationMatrix(sites,psi,Op1,Op2,{"NThread=",2});
+        auto R = corr(sites,psi,Op1,Op2);
+        for(auto i : range(Nc))
+        for(auto j : range(Nc))
+            {
+            CHECK_CLOSE(C(i,j),R(i,j));
+            }
+        };
+
+    auto sites = SpinHalf(Nc);
+    auto psi = evolved(sites,{{"Up","Dn","Up","Dn","Up","Dn"},
+                              {"Dn","Dn","Up","Up","Up","Dn"}},{"S+","S-"});
+    CHECK(maxLinkDim(psi) > 2);
+    psi *= 3.;
+    checkCorr(sites,psi,"Sz","Sz");
+    checkCorr(sites,psi,"S+","S-");
+    //Sz is conserved, so <Sz_i S+_j> = 0
+    auto Z = correlationMatrix(sites,psi,"Sz","S+");
+    CHECK(norm(Z) < 1E-12);
+
+    auto ex = expect(sites,psi,{"Sz","S+"});
+    CHECK(ex.size() == 2u);
+    for(auto j : range1(Nc))
+        {
+        auto ampo = AutoMPO(sites);
+        ampo += "Sz",j;
+        CHECK_CLOSE(ex[0][j-1],inner(psi,toMPO(ampo),psi)/inner(psi,psi));
+        CHECK_CLOSE(ex[1][j-1],0.);
+        }
+
+    //Jordan-Wigner strings for spinless fermions
+    auto fsites = Fermion(Nc);
+    auto fpsi = evolved(fsites,{{"Occ","Emp","Occ","Emp","Emp","Occ"},
+                                {"Emp","Occ","Occ","Occ","Emp","Emp"}},{"Cdag","C"});
+    checkCorr(fsites,fpsi,"Cdag","C");
+    checkCorr(fsites,fpsi,"C","Cdag");
+
+    //and for electrons
+    auto esites = Electron(Nc);
+    auto epsi = evolved(esites,{{"Up","Dn","UpDn","Emp","Up","Dn"},
+                                {"Dn","Up","Up","Dn","Emp","UpDn"}},{"Cdagup","Cup"});
+    epsi = sum(epsi,[&]
+        {
+        auto init = InitState(esites);
+        for(auto j : range1(Nc)) init.set(j,j%2==1 ? "Dn" : "Up");
+        return MPS(init);
+        }());
+    checkCorr(esites,epsi,"Cdagup","Cup");
+    checkCorr(esites,epsi,"Cdagdn","Cdn");
+    checkCorr(esites,epsi,"Nup","Ndn");
+
+    auto ec = correlationMatrixC(esites,epsi,"Cdagdn","Cdn");
+    auto n = expect(esites,epsi,{"Ndn"});
+    for(auto j : range(Nc))
+        {
+        CHECK_CLOSE(ec(j,j).real(),n[0][j]);
+        }
+    }
+
+SECTION("sample")
+    {
+    auto Nc = 4;
+    auto sites = SpinHalf(Nc);
+    auto terms = std::vector<MPS>{};
+    for(auto& st : std::vector<std::vector<std::string>>{{"Up","Dn","Up","Dn"},
+                                                         {"Dn","Up","Dn","Up"},
+                                                         {"Up","Up","Dn","Dn"}})
+        {
+        auto init = InitState(sites);
+        for(auto j : range1(Nc)) init.set(j,st.at(j-1));
+        terms.push_back(MPS(init));
+        }
+    auto psi = sum(terms);
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(Nc-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    psi = applyMPO(toExpH(ampo,0.3),psi);
+    psi.noPrime();
+    psi.ref(2) *= Cplx(0.6,0.8);
+    psi.position(Nc);
+
+    auto nsample = 5000;
+    auto S = sample(psi,nsample,{"BatchSize=",100,"NThread=",3});
+    CHECK(S.size() == size_t(nsample));
+    auto counts = std::map<std::vector<int>,int>{};
+    for(auto& st : S)
+        {
+        CHECK(st.size() == size_t(Nc));
+        //Sz is conserved
+        auto nup = 0;
+        for(auto k : st) nup += (k == 1);
+        CHECK(nup == Nc/2);
+        ++counts[st];
+        }
+    Real ptot = 0.;
+    for(auto& c : counts)
+        {
+        auto init = InitState(sites);
+        for(auto j : range1(Nc)) init.set(j,c.first[j-1] == 1 ? "Up" : "Dn");
+        auto p = std::norm(innerC(MPS(init),psi))/innerC(psi,psi).real();
+        ptot += p;
+        CHECK(std::fabs(Real(c.second)/nsample-p) < 5*std::sqrt(p*(1-p)/nsample));
+        }
+    CHECK_CLOSE(ptot,1.);
+
+    //Batches use their own random streams
+    CHECK(sample(psi,nsample,{"BatchSize=",100,"NThread=",1}) == S);
+    }
+
 }
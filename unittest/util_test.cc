@@ -3,6 +3,18 @@
 #include "itensor/global.h"
 #include "itensor/util/infarray.h"
 #include "itensor/util/stats.h"
+#include "itensor/util/vector_no_init.h"
+#include "itensor/util/profiler.h"
+#include "itensor/util/perfcounters.h"
+#include "itensor/util/memory_usage.h"
+#include "itensor/util/parallel_for.h"
+#include "itensor/util/telemetry.h"
+#include "itensor/util/random.h"
+#include "itensor/tensor/algs.h"
+#include "itensor/itensor.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 using namespace itensor;
 using namespace std;
@@ -261,3 +273,622 @@ SECTION("BinErr")
     }
 }
 
+
+TEST_CASE("StorageAlloc")
+{
+auto limit = storageCacheLimit();
+CHECK(limit == 0);
+
+SECTION("Alignment")
+    {
+    for(auto n : {1ul,100ul,5000ul,100000ul})
+        {
+        auto v = vector_no_init<Real>(n);
+        CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % StorageAlignment == 0);
+        }
+    }
+
+SECTION("Reuse Freed Buffers")
+    {
+    clearStorageCache();
+    setStorageCacheLimit(1ul<<20);
+    void* p = nullptr;
+        {
+        auto v = vector_no_init<Real>(10000);
+        p = v.data();
+        }
+    CHECK(storageCacheSize() >= 10000*sizeof(Real));
+    //Same size class is reused
+    auto w = vector_no_init<Real>(9990);
+    CHECK(w.data() == p);
+    CHECK(storageCacheSize() == 0);
+    }
+
+SECTION("Cache Limit")
+    {
+    clearStorageCache();
+    setStorageCacheLimit(0);
+        {
+        auto v = vector_no_init<Real>(10000);
+        }
+    CHECK(storageCacheSize() == 0);
+    setStorageCacheLimit(1ul<<20);
+        {
+        auto v = vector_no_init<Cplx>(10000);
+        }
+    CHECK(storageCacheSize() > 0);
+    setStorageCacheLimit(1000);
+    CHECK(storageCacheSize() == 0);
+    }
+
+SECTION("Threads")
+    {
+    clearStorageCache();
+    setStorageCacheLimit(1ul<<20);
+    auto work = []
+        {
+        for(int n = 0; n < 100; ++n)
+            {
+            auto v = vector_no_init<Real>(1000+100*(n%10));
+            v.front() = n;
+            }
+        };
+    auto threads = std::vector<std::thread>{};
+    for(int t = 0; t < 4; ++t) threads.emplace_back(work);
+    for(auto& th : threads) th.join();
+    CHECK(storageCacheSize() > 0);
+    CHECK(storageCacheSize() <= storageCacheLimit());
+    clearStorageCache();
+    CHECK(storageCacheSize() == 0);
+    setStorageCacheLimit(limit);
+    }
+
+SECTION("Huge Pages")
+    {
+    setStorageHugePages(true);
+        {
+        auto v = vector_no_init<Real>(HugePageSize/sizeof(Real)+1);
+        CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % HugePageSize == 0);
+        v.back() = 1.;
+        }
+    setStorageHugePages(false);
+    CHECK(!storageHugePages());
+    }
+
+setStorageCacheLimit(limit);
+}
+
+TEST_CASE("Profiler")
+{
+clearProfile();
+
+SECTION("Disabled")
+    {
+    CHECK(!profiling());
+        {
+        PROFILE_REGION("test.off");
+        }
+    CHECK(profileEvents().empty());
+    }
+
+SECTION("Nested Regions")
+    {
+    setProfiling(true);
+    auto start = profileNow();
+    auto pstart = profileSummary();
+        {
+        PROFILE_REGION("test.outer");
+        for(int n = 0; n < 3; ++n)
+            {
+            PROFILE_REGION("test.inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+    setProfiling(false);
+
+    auto events = profileEvents(start);
+    REQUIRE(events.size() == 4);
+    auto& outer = events.front();
+    CHECK(std::string(outer.name) == "test.outer");
+    CHECK(outer.depth == 0);
+    auto inner = 0.;
+    for(auto& ev : events)
+        {
+        if(std::string(ev.name) != "test.inner") continue;
+        CHECK(ev.depth == 1);
+        CHECK(ev.start >= outer.start);
+        inner += ev.time;
+        }
+    CHECK(outer.time >= inner);
+    CHECK_DIFF(outer.self,outer.time-inner,1E-12);
+
+    auto P = profileSummary(pstart);
+    REQUIRE(P.entries.size() == 2);
+    CHECK(P.entries.front().name == "test.outer");
+    CHECK(P.entries.back().name == "test.inner");
+    CHECK(P.entries.back().count == 3);
+    }
+
+SECTION("Threads")
+    {
+    setProfiling(true);
+    auto work = []
+        {
+        PROFILE_REGION("test.thread");
+        };
+    auto t1 = std::thread(work);
+    auto t2 = std::thread(work);
+    t1.join();
+    t2.join();
+    setProfiling(false);
+
+    auto events = profileEvents();
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].thread != events[1].thread);
+    }
+
+SECTION("Worker Threads")
+    {
+    setProfiling(true);
+    auto start = profileNow();
+        {
+        PROFILE_REGION("test.outer");
+        parallelFor(2,2,[](size_t)
+            {
+            PROFILE_REGION("test.worker");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            });
+        }
+    setProfiling(false);
+
+    auto nworker = 0;
+    for(auto& ev : profileEvents(start))
+        {
+        if(std::string(ev.name) != "test.worker") continue;
+        CHECK(ev.depth == 1);
+        ++nworker;
+        }
+    CHECK(nworker == 2);
+    }
+
+SECTION("Event Limit")
+    {
+    auto limit = profileEventLimit();
+    setProfileEventLimit(5);
+    setProfiling(true);
+    for(int n = 0; n < 20; ++n)
+        {
+        PROFILE_REGION("test.limit");
+        }
+    setProfiling(false);
+    setProfileEventLimit(limit);
+    CHECK(profileEvents().size() == 5);
+    auto P = profileSummary();
+    REQUIRE(P.entries.size() == 1);
+    CHECK(P.entries.front().count == 20);
+    }
+
+SECTION("End")
+    {
+    setProfiling(true);
+    auto pstart = profileSummary();
+    auto region = ProfileRegion("test.end");
+    region.end();
+    auto P = profileSummary(pstart);
+    setProfiling(false);
+    REQUIRE(P.entries.size() == 1);
+    CHECK(P.entries.front().name == "test.end");
+    CHECK(P.entries.front().count == 1);
+    }
+
+SECTION("Chrome Trace")
+    {
+    setProfiling(true);
+        {
+        PROFILE_REGION("test.trace");
+        }
+    setProfiling(false);
+    auto s = std::ostringstream{};
+    writeChromeTrace(s);
+    auto trace = s.str();
+    CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+    CHECK(trace.find("\"name\":\"test.trace\",\"ph\":\"X\"") != std::string::npos);
+    }
+
+clearProfile();
+}
+
+TEST_CASE("PerfCounters")
+{
+resetPerfCounters();
+
+SECTION("Disabled")
+    {
+    auto A = Matrix(20,20);
+    auto C = A*A;
+    CHECK(perfCounters().flops() == 0);
+    }
+
+SECTION("Gemm Flops")
+    {
+    setPerfCounting(true);
+    long N = 20;
+    auto A = Matrix(N,N);
+    auto B = CMatrix(N,N);
+    auto C = A*A;
+    auto D = B*B;
+    setPerfCounting(false);
+    auto P = perfCounters();
+    CHECK(P[PerfGemm].calls == 2);
+    CHECK_CLOSE(P[PerfGemm].flops,2.*N*N*N+8.*N*N*N);
+    CHECK(P[PerfGemm].time > 0);
+    }
+
+SECTION("Factorize Nested Calls")
+    {
+    setPerfCounting(true);
+    auto M = randomMat(30,20);
+    Matrix U,V;
+    Vector D;
+    SVD(M,U,D,V);
+    setPerfCounting(false);
+    auto P = perfCounters();
+    //SVD calls diagHermitian, counted as a single call
+    CHECK(P[PerfFactorize].calls == 1);
+    CHECK(P[PerfFactorize].flops > 0);
+    CHECK(P[PerfGemm].flops > 0);
+    }
+
+SECTION("Threads")
+    {
+    setPerfCounting(true);
+    auto work = []
+        {
+        auto A = Matrix(20,20);
+        auto C = A*A;
+        };
+    auto t1 = std::thread(work);
+    auto t2 = std::thread(work);
+    t1.join();
+    t2.join();
+    setPerfCounting(false);
+    auto nthread = 0;
+    for(auto& P : perfCountersByThread())
+        {
+        if(P[PerfGemm].calls > 0) ++nthread;
+        }
+    CHECK(nthread == 2);
+    CHECK(perfCounters()[PerfGemm].calls == 2);
+    }
+
+SECTION("Contraction")
+    {
+    auto i = Index(10),
+         j = Index(20),
+         k = Index(30);
+    auto A = randomITensor(i,j,k);
+    auto B = randomITensor(k,i);
+    setPerfCounting(true);
+    auto C = A*B;
+    setPerfCounting(false);
+    auto P = perfCounters();
+    CHECK(P[PerfContract].calls == 1);
+    CHECK(P[PerfContract].bytes_allocated >= sizeof(Real)*dim(j));
+    CHECK_CLOSE(P[PerfGemm].flops,2.*dim(i)*dim(j)*dim(k));
+    }
+
+resetPerfCounters();
+CHECK(perfCounters()[PerfGemm].calls == 0);
+}
+
+TEST_CASE("MemoryUsage")
+{
+auto i = Index(10),
+     j = Index(20),
+     k = Index(30);
+
+SECTION("Disabled")
+    {
+    auto start = memoryUsage().live;
+    auto A = randomITensor(i,j,k);
+    CHECK(memoryUsage().live == start);
+    }
+
+SECTION("Live and Peak")
+    {
+    setMemoryTracking(true);
+    auto start = memoryUsage(MemDense).live;
+    auto bytes = sizeof(Real)*dim(i)*dim(j)*dim(k);
+        {
+        auto A = randomITensor(i,j,k);
+        CHECK(memoryUsage(MemDense).live == start+bytes);
+        resetMemoryPeaks();
+        }
+    setMemoryTracking(false);
+    auto u = memoryUsage(MemDense);
+    CHECK(u.live == start);
+    CHECK(u.peak == start+bytes);
+    resetMemoryPeaks();
+    CHECK(memoryUsage(MemDense).peak == start);
+    }
+
+SECTION("Moved Into Storage")
+    {
+    setMemoryTracking(true);
+    auto other = memoryUsage(MemOther).live;
+    auto dense = memoryUsage(MemDense).live;
+    auto v = vector_no_init<Real>(100);
+    CHECK(memoryUsage(MemOther).live == other+100*sizeof(Real));
+    auto D = Dense<Real>(std::move(v));
+    setMemoryTracking(false);
+    CHECK(memoryUsage(MemOther).live == other);
+    CHECK(memoryUsage(MemDense).live == dense+100*sizeof(Real));
+    }
+
+SECTION("Freed After Tracking Off")
+    {
+    setMemoryTracking(true);
+    auto start = memoryUsage().live;
+    auto A = randomITensor(i,j,k);
+    setMemoryTracking(false);
+    CHECK(memoryUsage().live > start);
+    A = ITensor();
+    CHECK(memoryUsage().live == start);
+    }
+
+SECTION("Scopes")
+    {
+    setMemoryTracking(true);
+    auto start = memoryUsage("test.scope").live;
+    auto A = ITensor{};
+        {
+        auto ms = MemoryScope("test.scope");
+        A = randomITensor(i,j);
+        }
+    auto B = randomITensor(j,k);
+    CHECK(memoryUsage("test.scope").live == start+sizeof(Real)*dim(i)*dim(j));
+    auto C = A*B;
+    setMemoryTracking(false);
+    CHECK(memoryUsage("test.scope").live == start+sizeof(Real)*dim(i)*dim(j));
+    CHECK(memoryUsage("unused.scope").peak == 0);
+    auto s = std::ostringstream{};
+    s << memoryReport();
+    CHECK(s.str().find("test.scope") != std::string::npos);
+    }
+
+SECTION("Scopes In Worker Threads")
+    {
+    setMemoryTracking(true);
+    auto start = memoryUsage("test.workers").live;
+    auto T = std::vector<ITensor>(4);
+        {
+        auto ms = MemoryScope("test.workers");
+        parallelFor(T.size(),2,[&T,&i,&j](size_t n)
+            {
+            T[n] = randomITensor(i,j);
+            });
+        }
+    setMemoryTracking(false);
+    CHECK(memoryUsage("test.workers").live == start+T.size()*sizeof(Real)*dim(i)*dim(j));
+    }
+
+SECTION("Scratch")
+    {
+    auto A = randomITensor(i,j,k);
+    auto B = randomITensor(i,k);
+    setMemoryTracking(true);
+    resetMemoryPeaks();
+    //contracting over i,k requires permuting A
+    auto C = A*B;
+    setMemoryTracking(false);
+    CHECK(memoryUsage(MemScratch).peak >= sizeof(Real)*dim(i)*dim(j)*dim(k));
+    }
+
+SECTION("Limit")
+    {
+    setMemoryLimit(1);
+    CHECK(memoryTracking());
+    auto A = randomITensor(i,j,k);
+    CHECK(memoryLimitExceeded());
+    setMemoryLimit(0);
+    CHECK(!memoryLimitExceeded());
+    setMemoryTracking(false);
+    }
+}
+
+TEST_CASE("Telemetry")
+{
+auto readLines = [](std::string const& fname)
+    {
+    auto lines = std::vector<std::string>{};
+    auto f = std::ifstream(fname);
+    for(std::string l; std::getline(f,l);) lines.push_back(l);
+    return lines;
+    };
+
+SECTION("Off")
+    {
+    CHECK(!telemetryOn());
+    emitTelemetry(TelemetryRecord("test").add("x",1));
+    }
+
+SECTION("JSONL")
+    {
+    auto fname = std::string("telemetry_test.jsonl");
+    startTelemetry(fname);
+    CHECK(telemetryOn());
+    emitTelemetry(TelemetryRecord("test").add("n",3).add("x",0.5).add("s","a\"b"));
+    emitTelemetry(TelemetryRecord("other").add("y",NAN).add("ok",true));
+    flushTelemetry();
+    auto lines = readLines(fname);
+    REQUIRE(lines.size() == 2);
+    CHECK(lines[0] == "{\"record\":\"test\",\"n\":3,\"x\":0.5,\"s\":\"a\\\"b\"}");
+    CHECK(lines[1] == "{\"record\":\"other\",\"y\":null,\"ok\":true}");
+    stopTelemetry();
+    CHECK(!telemetryOn());
+    std::remove(fname.c_str());
+    }
+
+SECTION("CSV")
+    {
+    startTelemetry("telemetry_test.csv");
+    emitTelemetry(TelemetryRecord("a").add("n",1).add("x",2.5));
+    emitTelemetry(TelemetryRecord("b").add("s","p,q"));
+    emitTelemetry(TelemetryRecord("a").add("x",3.5).add("n",2));
+    stopTelemetry();
+    auto la = readLines("telemetry_test.a.csv");
+    REQUIRE(la.size() == 3);
+    CHECK(la[0] == "n,x");
+    CHECK(la[1] == "1,2.5");
+    CHECK(la[2] == "2,3.5");
+    auto lb = readLines("telemetry_test.b.csv");
+    REQUIRE(lb.size() == 2);
+    CHECK(lb[1] == "\"p,q\"");
+    std::remove("telemetry_test.a.csv");
+    std::remove("telemetry_test.b.csv");
+    }
+
+SECTION("Threads")
+    {
+    auto fname = std::string("telemetry_test.jsonl");
+    startTelemetry(fname);
+    auto work = []
+        {
+        for(auto n : range(100)) emitTelemetry(TelemetryRecord("t").add("n",n));
+        };
+    auto t1 = std::thread(work);
+    auto t2 = std::thread(work);
+    t1.join();
+    t2.join();
+    stopTelemetry();
+    CHECK(readLines(fname).size() == 200);
+    std::remove(fname.c_str());
+    }
+}
+
+TEST_CASE("Random")
+{
+
+SECTION("Philox4x32-10 Known Answers")
+    {
+    //Test vectors from the Random123 library
+    auto r0 = philox4x32({{0,0,0,0}},{{0,0}});
+    CHECK(r0 == Philox4x32Counter{{0x6627e8d5u,0xe169c58du,0xbc57ac4cu,0x9b00dbd8u}});
+    auto r1 = philox4x32({{0xffffffffu,0xffffffffu,0xffffffffu,0xffffffffu}},{{0xffffffffu,0xffffffffu}});
+    CHECK(r1 == Philox4x32Counter{{0x408f276du,0x41c83b0eu,0xa20bc7c6u,0x6d5451fdu}});
+    }
+
+SECTION("Streams")
+    {
+    auto S1 = RandomStream(7,3);
+    auto S2 = RandomStream(7,3);
+    auto S3 = RandomStream(7,4);
+    auto x = std::vector<Real>(10);
+    for(auto& el : x) el = S1.uniform();
+    for(auto& el : x)
+        {
+        CHECK(el >= 0.);
+        CHECK(el < 1.);
+        CHECK(el == S2.uniform());
+        }
+    CHECK(S3.uniform() != x[0]);
+    CHECK(uniformFromBits(0) == 0.);
+    CHECK(uniformFromBits(~uint64_t(0)) < 1.);
+
+    //Positions can be computed out of order
+    auto S4 = RandomStream(7,3);
+    S4.seek(5);
+    CHECK(S4.uniform() == x[5]);
+    CHECK(S4.position() == 6);
+    }
+
+SECTION("Seed")
+    {
+    seedRNG(11);
+    auto a = Global::random();
+    auto T1 = randomITensor(Index(3),Index(4));
+    seedRNG(11);
+    CHECK(Global::random() == a);
+    auto T2 = randomITensor(Index(3),Index(4));
+    CHECK(norm(T1) == norm(T2));
+    CHECK(elt(T1,1,1) == elt(T2,1,1));
+    CHECK(elt(T1,3,4) == elt(T2,3,4));
+
+    //Thread streams differ from each other
+    auto b = 0.;
+    auto t = std::thread([&b] { b = Global::random(); });
+    t.join();
+    seedRNG(11);
+    CHECK(b != Global::random());
+    }
+
+SECTION("Parallel Fill")
+    {
+    auto n = 200000ul;
+    auto x1 = std::vector<Real>(n),
+         x4 = std::vector<Real>(n);
+    randomFill(x1.data(),n,5,1);
+    randomFill(x4.data(),n,5,4);
+    CHECK(x1 == x4);
+    auto S = RandomStream(randomSeed(),5);
+    CHECK(x1[0] == S.uniform());
+    S.seek(n-1);
+    CHECK(x1[n-1] == S.uniform());
+
+    auto z1 = std::vector<Cplx>(n),
+         z3 = std::vector<Cplx>(n);
+    randomFill(z1.data(),n,5,1);
+    randomFill(z3.data(),n,5,3);
+    CHECK(z1 == z3);
+    CHECK(z1[0].real() == x1[0]);
+    CHECK(z1[0].imag() == x1[1]);
+
+    //Randomizing a large tensor does not depend on the number of threads
+    auto i = Index(400),
+         j = Index(400);
+    for(auto cplx : {false,true})
+        {
+        auto T1 = ITensor(i,j),
+             T4 = ITensor(i,j);
+        seedRNG(3);
+        T1.randomize({"Complex=",cplx,"NThread=",1});
+        seedRNG(3);
+        T4.randomize({"Complex=",cplx,"NThread=",4});
+        CHECK(isComplex(T4) == cplx);
+        CHECK(norm(T1-T4) == 0.);
+        CHECK(norm(T1) > 0.);
+        }
+    }
+
+}
+
+TEST_CASE("Global")
+{
+SECTION("Plain References")
+    {
+    bool& f = Global::debug1();
+    auto save = Global::printdat();
+    f = true;
+    CHECK(Global::debug1());
+    f = false;
+    Real& s = Global::printScale();
+    CHECK(s == Global::printScale());
+    CHECK(save == Global::printdat());
+    }
+
+SECTION("PrintData Leaves printdat Unchanged")
+    {
+    auto i = Index(2);
+    auto T = setElt(i=1);
+    auto t = std::thread([&T]
+        {
+        auto s = std::ostringstream{};
+        auto sb = std::cout.rdbuf(s.rdbuf());
+        PrintData(T);
+        std::cout.rdbuf(sb);
+        });
+    t.join();
+    CHECK(!Global::printdat());
+    CHECK(detail::printDataOverride() == -1);
+    }
+}